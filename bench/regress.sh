@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Compares two builds of the benchmark driver on one benchmark.
+# Usage: ./regress.sh [Baseline bench] [Candidate bench] [Write Count] [Read Count] [Benchmark #] [Trials] [extra arguments...]
+#
+# The two binaries are run in turn, one trial each per round, so that drift of the machine (frequency,
+# other load) hits both sides alike; then ./compare flags the significant regressions.
+
+if [ $# -lt 6 ]; then
+    sed -n 3,7p "$0"
+    exit 2
+fi
+
+baseline=$1
+candidate=$2
+write=$3
+read=$4
+option=$5
+trials=$6
+shift 6
+
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+for ((trial = 1; trial <= trials; trial++)); do
+    echo "Round $trial of $trials"
+    "$baseline" $write $read $option "$@" --out="$dir/baseline.json" > /dev/null || exit 2
+    "$candidate" $write $read $option "$@" --out="$dir/candidate.json" > /dev/null || exit 2
+done
+
+"$(dirname "$0")/compare" "$dir/baseline.json" "$dir/candidate.json"
@@ -0,0 +1,111 @@
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> frees{0};
+std::atomic<int64_t> live_bytes{0};
+std::atomic<int64_t> peak_bytes{0};
+
+void* Allocate(size_t size, bool nothrow) {
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        if (nothrow) return nullptr;
+        throw std::bad_alloc();
+    }
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    int64_t bytes = (int64_t)malloc_usable_size(p);
+    int64_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    // 최댓값은 CAS로 갱신 (다른 스레드가 더 큰 값을 먼저 썼으면 그대로 둔다)
+    int64_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return p;
+}
+
+void Release(void* p) {
+    if (!p) return;
+    frees.fetch_add(1, std::memory_order_relaxed);
+    live_bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    free(p);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return Allocate(size, false); }
+void* operator new[](size_t size) { return Allocate(size, false); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Allocate(size, true); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Allocate(size, true); }
+void operator delete(void* p) noexcept { Release(p); }
+void operator delete[](void* p) noexcept { Release(p); }
+void operator delete(void* p, size_t) noexcept { Release(p); }
+void operator delete[](void* p, size_t) noexcept { Release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { Release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { Release(p); }
+
+namespace alloc_counter {
+
+Snapshot Now() {
+    Snapshot snapshot;
+    snapshot.allocations = allocations.load(std::memory_order_relaxed);
+    snapshot.frees = frees.load(std::memory_order_relaxed);
+    snapshot.live_bytes = live_bytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+int64_t PeakLiveBytes() { return peak_bytes.load(std::memory_order_relaxed); }
+
+void ResetPeak() { peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+size_t CurrentRssBytes() {
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+    unsigned long size = 0, resident = 0;
+    int fields = fscanf(file, "%lu %lu", &size, &resident);
+    fclose(file);
+    return fields == 2 ? resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+}
+
+size_t PeakRssBytes() {
+    // VmHWM은 ResetPeakRss()로 내려가지만 ru_maxrss는 끝난 스레드의 최댓값을 계속 들고 있다
+    if (FILE* file = fopen("/proc/self/status", "r")) {
+        char line[256];
+        unsigned long kb = 0;
+        bool found = false;
+        while (!found && fgets(line, sizeof(line), file)) {
+            found = sscanf(line, "VmHWM: %lu kB", &kb) == 1;
+        }
+        fclose(file);
+        if (found) {
+            return (size_t)kb * 1024;
+        }
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (size_t)usage.ru_maxrss * 1024; // ru_maxrss is in KiB on Linux
+}
+
+bool ResetPeakRss() {
+    malloc_trim(0); // 앞에서 해제된 메모리가 RSS에 남아 있지 않도록
+    FILE* file = fopen("/proc/self/clear_refs", "w");
+    if (!file) {
+        return false;
+    }
+    bool ok = fputs("5", file) >= 0;
+    return fclose(file) == 0 && ok;
+}
+
+} // namespace alloc_counter
@@ -0,0 +1,38 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap accounting of the whole program.
+//
+// alloc_counter.cc replaces the global operator new/delete, so every allocation made through
+// new (the index nodes, std::vector and std::set storage) is counted on its way to malloc. Bytes are
+// the usable size malloc returned (malloc_usable_size), so rounding is included but the chunk header
+// is not. Over-aligned new (alignas > 16) and direct malloc calls are not counted. The counters are relaxed atomics: exact once the threads that allocate have been joined.
+namespace alloc_counter {
+
+struct Snapshot {
+    uint64_t allocations; // Calls to operator new since the start of the program
+    uint64_t frees;       // Calls to operator delete (of a non-null pointer)
+    int64_t live_bytes;   // Bytes allocated and not yet freed
+};
+
+Snapshot Now();
+
+// Highest live_bytes since the last ResetPeak() (or the start of the program)
+int64_t PeakLiveBytes();
+void ResetPeak();
+
+// Resident set size of the whole process: current (/proc/self/statm) and highest since the last
+// ResetPeakRss() (VmHWM in /proc/self/status, getrusage if that cannot be read)
+size_t CurrentRssBytes();
+size_t PeakRssBytes();
+// Returns the free heap pages malloc still holds to the kernel (malloc_trim), then lowers the RSS
+// high-water mark to the current RSS (/proc/self/clear_refs). Returns false if the kernel does not
+// allow the reset; PeakRssBytes() is then the peak since the start of the program.
+bool ResetPeakRss();
+
+} // namespace alloc_counter
+
+#endif
@@ -0,0 +1,909 @@
+#include <iostream>
+#include <set>
+#include <random>
+
+#include <chrono>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <mutex>
+
+#include "zipf.h"
+#include "latest-generator.h"
+#include "skiplist.h"
+#include "bplustree.h"
+#include "art.h"
+#include "kv_entry.h"
+#include "histogram.h"
+#include "trace.h"
+#include "perf_counters.h"
+#include "alloc_counter.h"
+#include "results.h"
+#include "key_stream.h"
+
+// One driver for every index: the workloads of lab1/lab2 are written once against the
+// Insert/Contains/Delete/Scan interface and run on each structure in turn. Every operation is timed
+// on its own, so a phase reports its latency distribution and not only its total time.
+
+static const int kDegree = 64;
+static const double kZipfTheta = 0.8; // Same skew as init_zipf_generator
+
+// Result file (--out) and the description of the current run, completed per phase into its records
+static ResultWriter results;
+static ResultRecord run_info;
+
+// Report::Run generates the keys of a phase into a KeyStream before timing it (--inline-keys: inside the loop)
+static bool materialize_keys = true;
+
+struct TreeIndex : public Bplustree<Key> {
+    TreeIndex() : Bplustree<Key>(kDegree) {}
+};
+
+// Baseline: std::set behind the same interface
+class SetIndex {
+   public:
+    void Insert(const Key& key) { keys.insert(key); }
+    bool Contains(const Key& key) const { return keys.count(key) != 0; }
+    bool Delete(const Key& key) { return keys.erase(key) != 0; }
+    std::vector<Key> Scan(const Key& key, const int scan_num) {
+        std::vector<Key> result;
+        for (auto itr = keys.lower_bound(key); itr != keys.end() && (int)result.size() < scan_num; ++itr) {
+            result.push_back(*itr);
+        }
+        return result;
+    }
+
+   private:
+    std::set<Key> keys;
+};
+
+// One measured phase of a workload
+struct Phase {
+    std::string name;
+    LatencyHistogram latency; // ns per operation
+    double seconds = 0;       // Wall time of the whole phase loop (key generation only with --inline-keys)
+    uint64_t result = 0;      // Sum of what the operations returned (hits, deleted keys, scanned keys)
+    bool counted = false;     // 'counters' holds the hardware counters of the whole phase
+    PerfCounters::Sample counters;
+    bool allocs_counted = false; // 'allocations' holds the heap allocations of the whole phase
+    uint64_t allocations = 0;
+    double generate_seconds = -1; // Key generation before the phase (< 0: keys were generated inside it)
+};
+
+// Report: Runs the phases of one workload on one index and prints them.
+class Report {
+   public:
+    // Run function: Calls op(next(i)) for i in [0, n); only the op call is inside the per-operation timer.
+    // 'op' returns a count that is summed into the phase result, so the compiler cannot drop a lookup.
+    // The keys are generated into a KeyStream first, so the phase time and counters hold no generator work;
+    // with --inline-keys next(i) is called inside the phase loop instead.
+    template<typename Next, typename Op>
+    void Run(const char* name, int n, Next next, Op op) {
+        if (!materialize_keys) {
+            Measure(name, n, next, op);
+            return;
+        }
+        KeyStream keys(n < 0 ? 0 : n, next);
+        Measure(name, n, [&](int i) { return (Key)keys[i]; }, op);
+        phases.back().generate_seconds = keys.GenerateSeconds();
+    }
+
+    // Add function: Phase measured by the caller (e.g. one operation type of a mixed run).
+    void Add(const Phase& phase) { phases.push_back(phase); }
+
+    // Print function: Prints the phases and appends them to the result file, if one is open.
+    void Print(const char* index_name) const {
+        for (const Phase& phase : phases) {
+            Save(index_name, phase);
+            double ops = phase.seconds > 0 ? phase.latency.Count() / phase.seconds : 0.0;
+            char allocs[16] = "n/a";
+            if (phase.allocs_counted && phase.latency.Count() > 0) {
+                snprintf(allocs, sizeof(allocs), "%.2lf", (double)phase.allocations / phase.latency.Count());
+            }
+            // 미리 만든 key stream의 생성 속도 (phase 시간에는 들어가지 않는다)
+            char keys[48] = "";
+            if (phase.generate_seconds > 0) {
+                snprintf(keys, sizeof(keys), ", Keys = %.1lf Mkeys/s", phase.latency.Count() / phase.generate_seconds * 1e-6);
+            }
+            printf("[%-9s] %-6s %9lu ops, %8.3lf Mops/s, %6s allocs/op, p50 = %8lu ns, p99 = %8lu ns, p99.9 = %8lu ns, max = %10lu ns, Result = %lu%s\n",
+                   index_name, phase.name.c_str(), (unsigned long)phase.latency.Count(), ops * 1e-6, allocs,
+                   (unsigned long)phase.latency.Percentile(50), (unsigned long)phase.latency.Percentile(99),
+                   (unsigned long)phase.latency.Percentile(99.9), (unsigned long)phase.latency.Max(),
+                   (unsigned long)phase.result, keys);
+            if (phase.counted) {
+                PrintCounters(phase);
+            }
+        }
+    }
+
+   private:
+    // Measure function: The timed loop of a phase; next(i) runs inside it, outside the per-operation timer.
+    template<typename Next, typename Op>
+    void Measure(const char* name, int n, Next next, Op op) {
+        Phase phase;
+        phase.name = name;
+        alloc_counter::Snapshot heap = alloc_counter::Now();
+        perf.Start();
+        auto start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            Key key = next(i);
+            auto op_start = Clock::now();
+            phase.result += op(key);
+            auto op_end = Clock::now();
+            phase.latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count());
+        }
+        phase.seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 1e-9;
+        phase.counters = perf.Stop();
+        phase.counted = perf.AnyAvailable();
+        phase.allocations = alloc_counter::Now().allocations - heap.allocations;
+        phase.allocs_counted = true;
+        phases.push_back(phase);
+    }
+
+    static void Save(const char* index_name, const Phase& phase) {
+        ResultRecord record = run_info;
+        record.structure = index_name;
+        record.phase = phase.name;
+        record.ops = phase.latency.Count();
+        record.seconds = phase.seconds;
+        record.p50 = phase.latency.Percentile(50);
+        record.p99 = phase.latency.Percentile(99);
+        record.p999 = phase.latency.Percentile(99.9);
+        record.max = phase.latency.Max();
+        record.mean = phase.latency.Mean();
+        record.result = phase.result;
+        double ops = record.ops ? (double)record.ops : 1.0;
+        if (phase.allocs_counted) {
+            record.allocs_per_op = phase.allocations / ops;
+        }
+        if (phase.generate_seconds > 0) {
+            record.keygen_mops = record.ops / phase.generate_seconds * 1e-6;
+        }
+        for (int e = 0; phase.counted && e < PerfCounters::EVENTS; e++) {
+            record.counters[e] = phase.counters.value[e] / ops;
+            record.counter_valid[e] = phase.counters.valid[e];
+        }
+        results.Write(record);
+    }
+
+    // Hardware counters per operation. They cover the whole phase loop: the reads of the pre-generated
+    // keys and the two clock reads around every operation are included (the same for every index), and
+    // the key generation too with --inline-keys.
+    static void PrintCounters(const Phase& phase) {
+        const PerfCounters::Sample& c = phase.counters;
+        double ops = phase.latency.Count() ? (double)phase.latency.Count() : 1.0;
+        printf("            per op:");
+        for (int e = 0; e < PerfCounters::EVENTS; e++) {
+            if (c.valid[e]) {
+                printf(" %s = %.2lf%s", PerfCounters::Name((PerfCounters::Event)e), c.value[e] / ops, e + 1 < PerfCounters::EVENTS ? "," : "");
+            } else {
+                printf(" %s = n/a%s", PerfCounters::Name((PerfCounters::Event)e), e + 1 < PerfCounters::EVENTS ? "," : "");
+            }
+        }
+        if (c.valid[PerfCounters::CYCLES] && c.valid[PerfCounters::INSTRUCTIONS] && c.value[PerfCounters::CYCLES] > 0) {
+            printf(" (IPC %.2lf)", c.value[PerfCounters::INSTRUCTIONS] / c.value[PerfCounters::CYCLES]);
+        }
+        printf("\n");
+    }
+
+    std::vector<Phase> phases;
+    PerfCounters perf; // Counters of this thread, opened once per report
+};
+
+template<typename Index>
+void Sequential(const int write, const int read, Index& idx, Report& report) {
+    report.Run("Insert", write, [](int i) { return (Key)i + 1; }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Lookup", read, [](int i) { return (Key)i + 1; }, [&](Key key) { return (int)idx.Contains(key); });
+}
+
+template<typename Index>
+void RevSequential(const int write, const int read, Index& idx, Report& report) {
+    report.Run("Insert", write, [&](int i) { return (Key)(write - i); }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Lookup", read, [&](int i) { return (Key)(read - i); }, [&](Key key) { return (int)idx.Contains(key); });
+}
+
+template<typename Index>
+void Uniform(const int write, const int read, Index& idx, Report& report) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> distr(1, write);
+    report.Run("Insert", write, [&](int) { return (Key)distr(gen) + 1; }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Lookup", read, [&](int) { return (Key)distr(gen) + 1; }, [&](Key key) { return (int)idx.Contains(key); });
+}
+
+template<typename Index>
+void Zipfian(const int write, const int read, Index& idx, Report& report) {
+    ZipfGenerator zipf(0, write, kZipfTheta, 1);
+    report.Run("Insert", write, [&](int) { return (Key)(zipf.Next() % write + 1); }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Lookup", read, [&](int) { return (Key)(zipf.Next() % read + 1); }, [&](Key key) { return (int)idx.Contains(key); });
+}
+
+template<typename Index>
+void Uniform_Delete(const int write, const int read, Index& idx, Report& report) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> distr(1, write);
+    report.Run("Insert", write, [&](int) { return (Key)distr(gen) + 1; }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Delete", read, [&](int) { return (Key)distr(gen) + 1; }, [&](Key key) { return (int)idx.Delete(key); });
+}
+
+template<typename Index>
+void Zipfian_Delete(const int write, const int read, Index& idx, Report& report) {
+    ZipfGenerator zipf(0, write, kZipfTheta, 1);
+    report.Run("Insert", write, [&](int) { return (Key)(zipf.Next() % write + 1); }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Delete", read, [&](int) { return (Key)(zipf.Next() % read + 1); }, [&](Key key) { return (int)idx.Delete(key); });
+}
+
+template<typename Index>
+void Uniform_Scan(const int write, const int read, Index& idx, Report& report) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> distr(0, write);
+    report.Run("Insert", write, [](int i) { return (Key)i + 1; }, [&](Key key) { idx.Insert(key); return 0; });
+    report.Run("Scan", read, [&](int) { return (Key)distr(gen) + 1; }, [&](Key key) { return (int)idx.Scan(key, 100).size(); });
+}
+
+// Runs one workload on a fresh index. The same seeds are used for every structure, so they all see the same keys.
+template<typename Index>
+void runOn(const char* name, void (*benchmarkFunc)(int, int, Index&, Report&), int write, int read) {
+    Index* idx = new Index();
+    Report report;
+    benchmarkFunc(write, read, *idx, report);
+    report.Print(name);
+    delete idx;
+}
+
+// Open-loop load: operations are issued on a fixed schedule (one every threads / rate seconds per thread)
+// whether or not the previous one has finished. Latency is taken from the intended start, so the time an
+// operation spends waiting behind a slow one (a leaf split, a rebalancing delete) is counted, instead of
+// being hidden by a closed loop that simply issues less (coordinated omission). The service time, from
+// the actual start, is recorded as well to show the difference.
+struct OpenLoopResult {
+    LatencyHistogram latency; // From the intended start (corrected)
+    LatencyHistogram service; // From the actual start (what a closed loop would report)
+    double seconds = 0;
+    uint64_t result = 0;      // Sum of the operation results (keeps the lookups alive)
+};
+
+// Mixed operation on a key of [1, 2 * write]: 50% Contains, 25% Insert, 25% Delete
+template<typename Index>
+int mixedOp(Index& idx, std::mt19937& gen, const int write) {
+    std::uniform_int_distribution<int> distr(1, 2 * write);
+    Key key = distr(gen);
+    switch (gen() % 4) {
+        case 0: idx.Insert(key); return 0;
+        case 1: return (int)idx.Delete(key);
+        default: return (int)idx.Contains(key);
+    }
+}
+
+// openLoop function: Issues 'ops' mixed operations at 'rate' ops/s in total from 'threads' threads.
+// The index is not thread-safe, so the threads share it under one lock (the wait is part of the latency).
+template<typename Index>
+OpenLoopResult openLoop(Index& idx, const int write, double rate, int ops, int threads) {
+    std::mutex mu;
+    std::vector<OpenLoopResult> partial(threads);
+    const double interval = threads * 1e9 / rate; // ns between two operations of one thread
+    const auto start = Clock::now() + std::chrono::milliseconds(1);
+
+    auto client = [&](int t) {
+        std::mt19937 gen(t + 1);
+        OpenLoopResult& r = partial[t];
+        for (int i = t; i < ops; i += threads) {
+            // 1. 예정된 시작 시각까지 기다린다 (ms 단위로 멀 때만 sleep, 나머지는 spin). 늦었으면 바로 보낸다
+            auto intended = start + std::chrono::nanoseconds((long long)(interval * (i / threads) + interval * t / threads));
+            auto now = Clock::now();
+            if (intended - now > std::chrono::milliseconds(2)) {
+                std::this_thread::sleep_for(intended - now - std::chrono::milliseconds(1));
+            }
+            while (Clock::now() < intended) {
+                if (threads > 1) std::this_thread::yield(); // 코어를 나눠 쓰는 다른 client에 양보
+            }
+
+            // 2. 실행 후 예정 시각 기준 지연과 실제 시작 기준 지연을 함께 기록
+            auto op_start = Clock::now();
+            {
+                std::lock_guard<std::mutex> lock(mu);
+                r.result += mixedOp(idx, gen, write);
+            }
+            auto op_end = Clock::now();
+            r.latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - intended).count());
+            r.service.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count());
+        }
+    };
+    std::vector<std::thread> clients;
+    for (int t = 1; t < threads; t++) {
+        clients.emplace_back(client, t);
+    }
+    client(0);
+    for (auto& c : clients) {
+        c.join();
+    }
+
+    OpenLoopResult result;
+    for (const OpenLoopResult& r : partial) {
+        result.latency.Merge(r.latency);
+        result.service.Merge(r.service);
+        result.result += r.result;
+    }
+    result.seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 1e-9;
+    return result;
+}
+
+// Open_Loop function: Sweeps the offered load from 10% to 120% of the capacity (the unpaced rate) of the mix
+// and prints one throughput / latency line per step (the throughput-vs-p99 curve of the structure).
+template<typename Index>
+void Open_Loop(const char* name, const int write, const int read, const int threads, Index& idx) {
+    auto save = [&](const std::string& phase, const OpenLoopResult& r) {
+        ResultRecord record = run_info;
+        record.structure = name;
+        record.phase = phase;
+        record.ops = r.latency.Count();
+        record.seconds = r.seconds;
+        record.p50 = r.latency.Percentile(50);
+        record.p99 = r.latency.Percentile(99);
+        record.p999 = r.latency.Percentile(99.9);
+        record.max = r.latency.Max();
+        record.mean = r.latency.Mean();
+        record.result = r.result;
+        results.Write(record);
+    };
+
+    // 1. 미리 채우고, 쉬지 않고 보냈을 때의 처리량을 최대 처리량으로 삼는다 (같은 측정 경로를 거치도록 openLoop로)
+    for (int i = 1; i <= write; i += 2) {
+        idx.Insert(i);
+    }
+    OpenLoopResult saturated = openLoop(idx, write, 1e15, read, threads);
+    double capacity = saturated.latency.Count() / saturated.seconds;
+    printf("Capacity = %.3lf Mops/s, Service p99 = %lu ns\n", capacity * 1e-6, (unsigned long)saturated.service.Percentile(99));
+    save("Capacity", saturated);
+
+    // 2. 목표 부하를 올려 가며 open loop로 실행
+    for (double load : {0.1, 0.25, 0.5, 0.75, 0.9, 1.0, 1.2}) {
+        OpenLoopResult r = openLoop(idx, write, capacity * load, read, threads);
+        printf("  Offered = %8.3lf Mops/s (%3.0lf%%), Achieved = %8.3lf Mops/s, p50 = %10lu ns, p99 = %10lu ns, p99.9 = %10lu ns, max = %10lu ns, Service p99 = %8lu ns\n",
+               capacity * load * 1e-6, load * 100, r.latency.Count() / r.seconds * 1e-6,
+               (unsigned long)r.latency.Percentile(50), (unsigned long)r.latency.Percentile(99),
+               (unsigned long)r.latency.Percentile(99.9), (unsigned long)r.latency.Max(),
+               (unsigned long)r.service.Percentile(99));
+        save("Load " + std::to_string((int)(load * 100)) + "%", r);
+    }
+}
+
+template<typename Index>
+void runOpenLoop(const char* name, int write, int read, int threads) {
+    Index* idx = new Index();
+    printf("[%-9s] ", name);
+    Open_Loop(name, write, read, threads, *idx);
+    delete idx;
+}
+
+// Zipf_Init function: Generator setup time for growing key spaces. ZetaSum (closed form) is checked
+// against the direct sum of n powers, which is only run up to 10^7 items.
+void Zipf_Init() {
+    for (double theta : {0.5, 0.8, 0.99}) {
+        for (uint64_t n = 1000; n <= 1000000000ull; n *= 10) {
+            auto f_start = Clock::now();
+            ZipfGenerator zipf(0, n - 1, theta, 1);
+            auto f_end = Clock::now();
+            double error_bound;
+            double fast = ZetaSum(n, theta, &error_bound);
+            printf("theta = %.2lf, n = %10lu: Init = %10.2lf µs (first = %lu), Error bound = %.1e",
+                   theta, (unsigned long)n, std::chrono::duration_cast<std::chrono::nanoseconds>(f_end - f_start).count() * 0.001,
+                   (unsigned long)zipf.Next(), error_bound);
+            if (n <= 10000000) {
+                auto e_start = Clock::now();
+                double exact = 0;
+                for (uint64_t i = 1; i <= n; i++) {
+                    exact += 1 / pow((double)i, theta);
+                }
+                auto e_end = Clock::now();
+                printf(", Direct sum = %12.2lf µs, Relative error = %.1e",
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(e_end - e_start).count() * 0.001, fabs(fast - exact) / exact);
+            }
+            printf("\n");
+        }
+    }
+}
+
+// YCSB core workloads. A run loads 'records' records and then issues 'ops' operations drawn from the
+// mix; each operation type gets its own latency histogram, and its throughput is its count over the
+// wall time of the run. Records are KVEntry<Key, uint64_t> in SkipList / Bplustree (Upsert / Find /
+// ScanVisit), so an update overwrites the value of an existing record instead of adding a key.
+typedef KVEntry<Key, uint64_t> Record;
+
+struct YcsbSpec {
+    const char* name;
+    double read, update, insert, scan, rmw; // Operation mix (normalized to their sum)
+    char distribution;                      // 'u'niform, 'z'ipfian (scrambled) or 'l'atest
+    int max_scan;                           // Scan lengths are uniform in [1, max_scan]
+};
+
+static const YcsbSpec kYcsb[] = {
+    {"A", 0.50, 0.50, 0.00, 0.00, 0.00, 'z', 100}, // Update heavy
+    {"B", 0.95, 0.05, 0.00, 0.00, 0.00, 'z', 100}, // Read mostly
+    {"C", 1.00, 0.00, 0.00, 0.00, 0.00, 'z', 100}, // Read only
+    {"D", 0.95, 0.00, 0.05, 0.00, 0.00, 'l', 100}, // Read latest
+    {"E", 0.00, 0.00, 0.05, 0.95, 0.00, 'z', 100}, // Short ranges
+    {"F", 0.50, 0.00, 0.00, 0.00, 0.50, 'z', 100}, // Read-modify-write
+};
+
+// Overrides fields of 'spec' from "read=0.9,update=0.1,dist=latest,scan_length=50" (unknown names are ignored).
+YcsbSpec parseYcsb(YcsbSpec spec, const char* overrides) {
+    std::string list = overrides ? overrides : "";
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        std::string item = list.substr(pos, end - pos);
+        size_t eq = item.find('=');
+        if (eq != std::string::npos) {
+            std::string name = item.substr(0, eq);
+            const char* value = item.c_str() + eq + 1;
+            if (name == "read") spec.read = atof(value);
+            else if (name == "update") spec.update = atof(value);
+            else if (name == "insert") spec.insert = atof(value);
+            else if (name == "scan") spec.scan = atof(value);
+            else if (name == "rmw") spec.rmw = atof(value);
+            else if (name == "dist") spec.distribution = value[0];
+            else if (name == "scan_length") spec.max_scan = std::max(atoi(value), 1);
+        }
+        pos = end + 1;
+    }
+    return spec;
+}
+
+// Records are keyed by a hash of their insertion number, as YCSB does, so inserts are not sequential.
+Key recordKey(uint64_t n) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (int i = 0; i < 8; i++) {
+        h = (h ^ ((n >> (i * 8)) & 0xff)) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+template<typename Index>
+void Ycsb(const YcsbSpec& spec, const int records, const int ops, Index& idx, Report& report) {
+    enum { READ, UPDATE, INSERT, SCAN, RMW, TYPES };
+    static const char* kNames[TYPES] = {"Read", "Update", "Insert", "Scan", "RMW"};
+
+    // 1. 적재: 0..records-1번 레코드
+    report.Run("Load", records, [](int i) { return recordKey(i); }, [&](Key key) { idx.Upsert(Record(key, 0)); return 0; });
+
+    // 2. 연산 비율을 누적 확률로
+    double mix[TYPES] = {spec.read, spec.update, spec.insert, spec.scan, spec.rmw};
+    double total = 0;
+    for (double m : mix) total += m;
+    double cumulative[TYPES];
+    for (int t = 0; t < TYPES; t++) {
+        cumulative[t] = (t ? cumulative[t - 1] : 0) + (total > 0 ? mix[t] / total : 0);
+    }
+
+    Xoshiro256 rng(1);
+    ZipfGenerator zipf(0, std::max(records, 1) - 1, kZipfTheta, 2, true);
+    LatestGenerator latest(std::max(records, 1), kZipfTheta, 3);
+    uint64_t count = records; // 지금까지 들어간 레코드 수 (insert로 늘어난다)
+
+    Phase phases[TYPES];
+    for (int t = 0; t < TYPES; t++) phases[t].name = kNames[t];
+
+    // 3. 연산마다 종류와 레코드를 고르고 (시간 밖), 연산만 잰다
+    auto start = Clock::now();
+    for (int i = 0; i < ops; i++) {
+        double p = rng.NextDouble();
+        int type = 0;
+        while (type < TYPES - 1 && p >= cumulative[type]) type++;
+
+        uint64_t n;
+        if (type == INSERT || count == 0) {
+            n = count;
+        } else if (spec.distribution == 'l') {
+            n = latest.Next();
+        } else if (spec.distribution == 'u') {
+            n = rng.Next() % count;
+        } else {
+            n = zipf.Next();
+        }
+        Key key = recordKey(n);
+        int scan_length = type == SCAN ? 1 + rng.Next() % spec.max_scan : 0;
+
+        uint64_t result = 0;
+        auto op_start = Clock::now();
+        switch (type) {
+            case READ: {
+                const Record* record = idx.Find(Record(key));
+                result = record != nullptr;
+                break;
+            }
+            case UPDATE:
+            case INSERT:
+                idx.Upsert(Record(key, i));
+                break;
+            case SCAN:
+                idx.ScanVisit(Record(key), scan_length, [&](const Record& record) { result += record.value != ~0ull; });
+                break;
+            case RMW: {
+                const Record* record = idx.Find(Record(key));
+                idx.Upsert(Record(key, record ? record->value + 1 : 0));
+                result = record != nullptr;
+                break;
+            }
+        }
+        auto op_end = Clock::now();
+        phases[type].latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count());
+        phases[type].result += result;
+
+        if (type == INSERT) {
+            count++;
+            latest.Grow();
+        }
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 1e-9;
+    for (Phase& phase : phases) {
+        if (phase.latency.Count() > 0) {
+            phase.seconds = seconds;
+            report.Add(phase);
+        }
+    }
+}
+
+template<typename Index>
+void runYcsb(const char* name, const YcsbSpec& spec, int records, int ops, Index* idx) {
+    Report report;
+    Ycsb(spec, records, ops, *idx, report);
+    report.Print(name);
+    delete idx;
+}
+
+void Ycsb_All(const YcsbSpec& spec, int records, int ops) {
+    const char* dist = spec.distribution == 'l' ? "latest" : spec.distribution == 'u' ? "uniform" : "zipfian";
+    printf("Mix: read %.2lf, update %.2lf, insert %.2lf, scan %.2lf (1..%d), rmw %.2lf; distribution %s\n\n",
+           spec.read, spec.update, spec.insert, spec.scan, spec.max_scan, spec.rmw, dist);
+    runYcsb("SkipList", spec, records, ops, new SkipList<Record>());
+    runYcsb("Bplustree", spec, records, ops, new Bplustree<Record>(kDegree));
+}
+
+// Trace recording: TracedIndex forwards every call to the index it wraps and appends it to a trace,
+// so any workload (or a service built on these indexes) can be recorded and replayed later.
+template<typename Index>
+class TracedIndex : public Index {
+   public:
+    void Insert(const Key& key) { trace.Append(TRACE_INSERT, key); Index::Insert(key); }
+    bool Contains(const Key& key) { trace.Append(TRACE_CONTAINS, key); return Index::Contains(key); }
+    bool Delete(const Key& key) { trace.Append(TRACE_DELETE, key); return Index::Delete(key); }
+    std::vector<Key> Scan(const Key& key, const int scan_num) {
+        trace.Append(TRACE_SCAN, key, scan_num);
+        return Index::Scan(key, scan_num);
+    }
+
+    TraceWriter trace;
+};
+
+// Record_Trace function: Records a load of 'write' uniform keys followed by 'read' Zipfian operations
+// (60% lookup, 15% insert, 15% delete, 10% scan of 1..100 keys) into 'path'.
+void Record_Trace(const int write, const int read, const char* path) {
+    TracedIndex<SetIndex> idx;
+    Xoshiro256 rng(1);
+    ZipfGenerator zipf(1, std::max(write, 1), kZipfTheta, 2, true);
+    for (int i = 0; i < write; i++) {
+        idx.Insert(1 + rng.Next() % std::max(write, 1));
+    }
+    for (int i = 0; i < read; i++) {
+        Key key = zipf.Next();
+        uint64_t p = rng.Next() % 100;
+        if (p < 60) idx.Contains(key);
+        else if (p < 75) idx.Insert(key);
+        else if (p < 90) idx.Delete(key);
+        else idx.Scan(key, 1 + rng.Next() % 100);
+    }
+    if (!idx.trace.Close(path)) {
+        perror(path);
+        return;
+    }
+    printf("Recorded %lu operations into %s (%lu bytes, %.2lf bytes/operation)\n", (unsigned long)idx.trace.Ops(), path,
+           (unsigned long)idx.trace.Bytes(), idx.trace.Ops() ? (double)idx.trace.Bytes() / idx.trace.Ops() : 0.0);
+}
+
+// Replay function: Streams the trace through a fresh index. With several threads every thread owns
+// an index and applies only the operations whose key hashes to it (a scan then only sees that
+// thread's keys); each thread decodes the mapped trace on its own, outside the per-operation timer.
+template<typename Index>
+void Replay(const TraceReader& trace, const int threads, Report& report) {
+    static const char* kNames[4] = {"Insert", "Lookup", "Delete", "Scan"};
+    std::vector<std::vector<Phase>> partial(threads, std::vector<Phase>(4));
+
+    auto worker = [&](int t) {
+        Index* idx = new Index();
+        std::vector<Phase>& phases = partial[t];
+        TraceReader::Cursor cursor = trace.Begin();
+        TraceRecord record;
+        while (cursor.Next(record)) {
+            if (threads > 1 && ((record.key * 0x9E3779B97F4A7C15ull) >> 32) % threads != (uint64_t)t) {
+                continue;
+            }
+            uint64_t result = 0;
+            auto op_start = Clock::now();
+            switch (record.op) {
+                case TRACE_INSERT: idx->Insert(record.key); break;
+                case TRACE_CONTAINS: result = idx->Contains(record.key); break;
+                case TRACE_DELETE: result = idx->Delete(record.key); break;
+                case TRACE_SCAN: result = idx->Scan(record.key, record.scan_length).size(); break;
+            }
+            auto op_end = Clock::now();
+            phases[record.op].latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count());
+            phases[record.op].result += result;
+        }
+        delete idx;
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& w : workers) {
+        w.join();
+    }
+    double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 1e-9;
+
+    for (int op = 0; op < 4; op++) {
+        Phase phase;
+        phase.name = kNames[op];
+        phase.seconds = seconds;
+        for (int t = 0; t < threads; t++) {
+            phase.latency.Merge(partial[t][op].latency);
+            phase.result += partial[t][op].result;
+        }
+        if (phase.latency.Count() > 0) {
+            report.Add(phase);
+        }
+    }
+}
+
+template<typename Index>
+void runReplay(const char* name, const TraceReader& trace, int threads) {
+    Report report;
+    Replay<Index>(trace, threads, report);
+    report.Print(name);
+}
+
+void Replay_Trace(const char* path, int threads) {
+    TraceReader trace;
+    if (!trace.Open(path)) {
+        fprintf(stderr, "%s: not a readable trace file\n", path);
+        return;
+    }
+    printf("Replaying %lu operations (%lu bytes) from %s on %d thread%s\n\n", (unsigned long)trace.Ops(),
+           (unsigned long)trace.Bytes(), path, threads, threads > 1 ? "s" : "");
+    runReplay<SkipList<Key>>("SkipList", trace, threads);
+    runReplay<TreeIndex>("Bplustree", trace, threads);
+    runReplay<Art<Key>>("Art", trace, threads);
+    runReplay<SetIndex>("std::set", trace, threads);
+}
+
+// Structure-level breakdown next to the heap totals of Memory(); structures without a MemoryUsage() print nothing.
+template<typename Index>
+void printMemoryUsage(const Index&) {}
+
+void printMemoryUsage(const SkipList<Key>& list) {
+    SkipList<Key>::MemoryStats m = list.MemoryUsage();
+    printf("            %lu nodes, height %d, %.2lf pointers/node\n", (unsigned long)m.nodes, m.height, m.pointers_per_node);
+    printf("            keys %lu B, pointers %lu B, node headers %lu B, malloc overhead %lu B, cache/filter %lu B, total %lu B\n",
+           (unsigned long)m.key_bytes, (unsigned long)m.pointer_bytes, (unsigned long)m.header_bytes,
+           (unsigned long)m.allocator_bytes, (unsigned long)m.aux_bytes, (unsigned long)m.total_bytes);
+}
+
+void printMemoryUsage(const TreeIndex& tree) {
+    Bplustree<Key>::MemoryStats m = tree.MemoryUsage();
+    printf("            %lu leaves (%.1lf%% full), %lu internal nodes (%.1lf%% full), height %d\n", (unsigned long)m.leaves,
+           m.leaf_fill * 100, (unsigned long)m.internal_nodes, m.internal_fill * 100, m.height);
+    printf("            keys %lu B, pointers %lu B, unused capacity %lu B, node headers %lu B, malloc overhead %lu B, aux %lu B, total %lu B\n",
+           (unsigned long)m.key_bytes, (unsigned long)m.pointer_bytes, (unsigned long)m.slack_bytes, (unsigned long)m.header_bytes,
+           (unsigned long)m.allocator_bytes, (unsigned long)m.aux_bytes, (unsigned long)m.total_bytes);
+}
+
+void printMemoryUsage(const Art<Key>& art) {
+    printf("            %lu B by the tree's own count\n", (unsigned long)art.MemoryBytes());
+}
+
+// Loads 'keys' into a fresh index and reports its heap footprint: live bytes per key after the load,
+// allocations per insert, and the peak heap. The key vector is built before the first snapshot.
+// RSS is process-wide (key vector and memory malloc kept from earlier structures included), so it is
+// reported as the growth over the load and the peak during it; the peak covers the whole run if the
+// kernel does not let the high-water mark be reset.
+template<typename Index>
+void runMemory(const char* name, const std::vector<Key>& keys) {
+    alloc_counter::ResetPeak();
+    bool rss_reset = alloc_counter::ResetPeakRss();
+    size_t rss_before = alloc_counter::CurrentRssBytes();
+    alloc_counter::Snapshot before = alloc_counter::Now();
+    Index* idx = new Index();
+    Report report;
+    report.Run("Insert", (int)keys.size(), [&](int i) { return keys[i]; }, [&](Key key) { idx->Insert(key); return 0; });
+    alloc_counter::Snapshot after = alloc_counter::Now();
+    report.Print(name);
+
+    // Report의 Phase 하나(histogram)도 live bytes에 들어가지만 key 수에 비하면 무시할 만하다
+    double n = keys.empty() ? 1.0 : (double)keys.size();
+    printf("            %.1lf bytes/key live, %.2lf allocs/key, peak heap %.1lf MB\n",
+           (after.live_bytes - before.live_bytes) / n, (after.allocations - before.allocations) / n,
+           (alloc_counter::PeakLiveBytes() - before.live_bytes) / 1048576.0);
+    size_t rss_after = alloc_counter::CurrentRssBytes();
+    printf("            process RSS %.1lf MB (%+.1lf MB over the load), peak %.1lf MB %s\n", rss_after / 1048576.0,
+           ((double)rss_after - (double)rss_before) / 1048576.0, alloc_counter::PeakRssBytes() / 1048576.0,
+           rss_reset ? "during the load" : "since the start (high-water mark not resettable)");
+    printMemoryUsage(*idx);
+    delete idx;
+}
+
+void Memory(const int write) {
+    // 서로 다른 key 'write'개를 섞은 순서로 (중복 삽입을 무시하는 구조와 허용하는 구조가 같은 수를 갖도록)
+    std::vector<Key> keys(write);
+    for (int i = 0; i < write; i++) {
+        keys[i] = (Key)i + 1;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+    runMemory<SkipList<Key>>("SkipList", keys);
+    runMemory<TreeIndex>("Bplustree", keys);
+    runMemory<Art<Key>>("Art", keys);
+    runMemory<SetIndex>("std::set", keys);
+}
+
+void printUsage(const char* programName) {
+    std::cerr << "\nUsage: " << programName << " [Write Count] [Read Count] [Benchmark #] [Threads (open loop) | Mix (YCSB) | Trace file] [Threads (replay)]\n"
+              << "           [--trials=N] [--out=results.json | results.csv] [--inline-keys]\n\n"
+              << "Every benchmark runs on SkipList, Bplustree (degree " << kDegree << "), Art and std::set.\n"
+              << "Each phase prints its throughput and per-operation latency percentiles in ns\n"
+              << "(one clock read, a few tens of ns, is included in every latency).\n"
+              << "--trials=N runs the benchmark N times; --out=FILE appends one record per phase and trial to FILE\n"
+              << "(JSON lines, or CSV if FILE ends in .csv), to be compared with ./compare.\n"
+              << "The keys of a phase are generated before it is timed (Keys = generator rate); --inline-keys\n"
+              << "generates them inside the phase loop instead, so phase throughput includes the generator.\n\n"
+              << "Synthetic Benchmarks:\n"
+              << " 0 - Sequential\n"
+              << " 1 - Rev-Sequential\n"
+              << " 2 - Uniform\n"
+              << " 3 - Zipfian\n"
+              << " 4 - Uniform Delete\n"
+              << " 5 - Zipfian Delete\n"
+              << " 6 - Scan\n\n"
+              << "Open-Loop Benchmark (50% lookup, 25% insert, 25% delete, offered load swept from 10% to 120%\n"
+              << "of the unpaced capacity, latency measured from the scheduled start):\n"
+              << " 7 - Open-Loop Sweep\n\n"
+              << "Generator Benchmark (counts are ignored):\n"
+              << " 8 - Zipf Init (closed-form zeta vs the direct sum)\n\n"
+              << "YCSB Core Workloads on SkipList and Bplustree ([Write Count] records, [Read Count] operations).\n"
+              << "The 4th argument overrides the mix, e.g. read=0.9,update=0.1,dist=uniform|zipfian|latest,scan_length=50:\n"
+              << " 9 - YCSB A (50% read, 50% update, zipfian)\n"
+              << "10 - YCSB B (95% read, 5% update, zipfian)\n"
+              << "11 - YCSB C (100% read, zipfian)\n"
+              << "12 - YCSB D (95% read, 5% insert, latest)\n"
+              << "13 - YCSB E (95% scan, 5% insert, zipfian)\n"
+              << "14 - YCSB F (50% read, 50% read-modify-write, zipfian)\n\n"
+              << "Trace Benchmarks (binary trace file given as the 4th argument):\n"
+              << "15 - Record Trace (load [Write Count] keys, then [Read Count] mixed zipfian operations)\n"
+              << "16 - Replay Trace (counts are ignored; a 5th argument splits the replay over threads by key hash)\n\n"
+              << "Memory Benchmark (heap bytes and allocations counted by a replaced operator new):\n"
+              << "17 - Memory (load [Write Count] distinct keys, report bytes/key, allocs/key and peak heap/RSS)\n";
+}
+
+// Runs benchmark 'B' once. Returns false if the arguments do not name a runnable benchmark.
+bool runBenchmark(const int B, const int W, const int R, const char* extra, const int replay_threads) {
+    const int T = extra ? std::max(std::atoi(extra), 1) : 1;  // Open-loop client threads
+
+    auto begin = [](const std::string& workload) {
+        run_info.workload = workload;
+        std::cout << "\n[" << workload << " Benchmark in progress...]\n\n";
+    };
+
+#define RUN_ALL(name, func)                                                \
+    do {                                                                   \
+        begin(name);                                                       \
+        runOn<SkipList<Key>>("SkipList", func, W, R);                      \
+        runOn<TreeIndex>("Bplustree", func, W, R);                         \
+        runOn<Art<Key>>("Art", func, W, R);                                \
+        runOn<SetIndex>("std::set", func, W, R);                           \
+    } while (0)
+
+    switch (B) {
+        case 0: RUN_ALL("Sequential", Sequential); break;
+        case 1: RUN_ALL("Rev-Sequential", RevSequential); break;
+        case 2: RUN_ALL("Uniform", Uniform); break;
+        case 3: RUN_ALL("Zipfian", Zipfian); break;
+        case 4: RUN_ALL("Uniform Delete", Uniform_Delete); break;
+        case 5: RUN_ALL("Zipfian Delete", Zipfian_Delete); break;
+        case 6: RUN_ALL("Scan", Uniform_Scan); break;
+        case 7:
+            begin("Open-Loop Sweep");
+            runOpenLoop<SkipList<Key>>("SkipList", W, R, T);
+            runOpenLoop<TreeIndex>("Bplustree", W, R, T);
+            runOpenLoop<Art<Key>>("Art", W, R, T);
+            runOpenLoop<SetIndex>("std::set", W, R, T);
+            break;
+        case 8: begin("Zipf Init"); Zipf_Init(); break;
+        case 9: case 10: case 11: case 12: case 13: case 14: {
+            const YcsbSpec spec = parseYcsb(kYcsb[B - 9], extra);
+            begin(std::string("YCSB ") + spec.name);
+            Ycsb_All(spec, W, R);
+            break;
+        }
+        case 15:
+        case 16:
+            if (!extra) {
+                std::cerr << "A trace file is required.\n";
+                return false;
+            }
+            begin(B == 15 ? "Record Trace" : "Replay Trace");
+            if (B == 15) {
+                Record_Trace(W, R, extra);
+            } else {
+                Replay_Trace(extra, replay_threads);
+            }
+            break;
+        case 17: begin("Memory"); Memory(W); break;
+
+        default:
+            std::cerr << "Invalid benchmark option provided.\n";
+            return false;
+    }
+#undef RUN_ALL
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    // --out=FILE, --trials=N and --inline-keys may appear anywhere; the rest are the positional arguments
+    const char* out = nullptr;
+    int trials = 1;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; i++) {
+        if (i > 0 && strncmp(argv[i], "--out=", 6) == 0) {
+            out = argv[i] + 6;
+        } else if (i > 0 && strncmp(argv[i], "--trials=", 9) == 0) {
+            trials = std::max(std::atoi(argv[i] + 9), 1);
+        } else if (i > 0 && strcmp(argv[i], "--inline-keys") == 0) {
+            materialize_keys = false;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (args.size() < 4 || args.size() > 6) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const int W = std::atoi(args[1]);  // Insertion count
+    const int R = std::atoi(args[2]);  // Lookup count
+    const int B = std::atoi(args[3]);  // Benchmark type
+    const char* extra = args.size() >= 5 ? args[4] : nullptr;
+    const int replay_threads = args.size() == 6 ? std::max(std::atoi(args[5]), 1) : 1;
+
+    if (out && !results.Open(out)) {
+        perror(out);
+        return 1;
+    }
+    run_info.write = W;
+    run_info.read = R;
+    run_info.extra = extra ? extra : "";
+
+    {
+        PerfCounters probe;
+        if (!probe.AnyAvailable()) {
+            std::cout << "Hardware counters unavailable (" << strerror(probe.OpenError()) << "), reporting latency only.\n";
+        }
+    }
+
+    for (int trial = 0; trial < trials; trial++) {
+        if (trials > 1) {
+            std::cout << "\n=== Trial " << trial + 1 << " of " << trials << " ===\n";
+        }
+        run_info.trial = trial;
+        if (!runBenchmark(B, W, R, extra, replay_threads)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    return 0;
+}
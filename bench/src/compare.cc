@@ -0,0 +1,304 @@
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+// Regression comparator for the result files of ./bench --out (JSON lines or CSV).
+//
+// Records are grouped by what was run (workload, structure, phase, counts, extra argument); the trials
+// of a group are the samples. For every group found in both files, throughput and the p50 / p99
+// latencies are compared with Welch's t interval on the difference of the means: a change is reported
+// as significant only if the whole confidence interval lies on one side of zero, and as a regression
+// if it is also larger than the threshold and in the bad direction. Exits with 1 if any regression
+// was found, so it can gate a script.
+
+// One file's samples of one group
+struct Samples {
+    std::vector<double> mops;
+    std::vector<double> p50;
+    std::vector<double> p99;
+};
+
+typedef std::map<std::string, std::string> Fields;
+
+// ParseJson function: Reads one flat JSON object (string, number and null values) into 'fields'.
+static bool ParseJson(const std::string& line, Fields& fields) {
+    size_t i = line.find('{');
+    if (i == std::string::npos) {
+        return false;
+    }
+    auto skip = [&]() { while (i < line.size() && isspace((unsigned char)line[i])) i++; };
+    auto string = [&](std::string& out) {
+        out.clear();
+        if (line[i] != '"') return false;
+        for (i++; i < line.size() && line[i] != '"'; i++) {
+            if (line[i] == '\\' && i + 1 < line.size()) {
+                i++;
+                if (line[i] == 'u' && i + 4 < line.size()) {
+                    out += (char)strtol(line.substr(i + 1, 4).c_str(), nullptr, 16);
+                    i += 4;
+                    continue;
+                }
+            }
+            out += line[i];
+        }
+        i++;
+        return true;
+    };
+    for (i++;;) {
+        skip();
+        if (i >= line.size()) return false;
+        if (line[i] == '}') return true;
+        if (line[i] == ',') {
+            i++;
+            continue;
+        }
+        std::string name, value;
+        if (!string(name)) return false;
+        skip();
+        if (i >= line.size() || line[i] != ':') return false;
+        i++;
+        skip();
+        if (i < line.size() && line[i] == '"') {
+            if (!string(value)) return false;
+        } else {
+            size_t end = line.find_first_of(",}", i);
+            if (end == std::string::npos) return false;
+            value = line.substr(i, end - i);
+            while (!value.empty() && isspace((unsigned char)value.back())) value.pop_back();
+            i = end;
+        }
+        fields[name] = value == "null" ? "" : value;
+    }
+}
+
+// SplitCsv function: Splits one CSV line, undoing the quoting of fields that contain ',' or '"'.
+static std::vector<std::string> SplitCsv(const std::string& line) {
+    std::vector<std::string> cells(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                cells.back() += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                cells.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            cells.emplace_back();
+        } else if (c != '\r') {
+            cells.back() += c;
+        }
+    }
+    return cells;
+}
+
+// Load function: Adds every record of 'path' to 'groups'. Returns the number of records, -1 if unreadable.
+static long Load(const char* path, std::map<std::string, Samples>& groups) {
+    std::ifstream in(path);
+    if (!in) {
+        return -1;
+    }
+    long records = 0;
+    std::vector<std::string> header;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        // 1. 한 줄을 field 이름 → 값으로 (JSON이면 그대로, CSV면 첫 줄의 header로)
+        Fields fields;
+        if (line[line.find_first_not_of(" \t")] == '{') {
+            if (!ParseJson(line, fields)) continue;
+        } else if (header.empty()) {
+            header = SplitCsv(line);
+            continue;
+        } else {
+            std::vector<std::string> cells = SplitCsv(line);
+            for (size_t c = 0; c < cells.size() && c < header.size(); c++) {
+                fields[header[c]] = cells[c];
+            }
+        }
+        if (fields["mops"].empty()) {
+            continue;
+        }
+
+        // 2. 무엇을 돌렸는지가 같은 record끼리 묶는다
+        std::string key = fields["workload"] + " | " + fields["structure"] + " | " + fields["phase"] + " | W=" +
+                          fields["write"] + " R=" + fields["read"] + (fields["extra"].empty() ? "" : " " + fields["extra"]);
+        Samples& samples = groups[key];
+        samples.mops.push_back(atof(fields["mops"].c_str()));
+        samples.p50.push_back(atof(fields["p50_ns"].c_str()));
+        samples.p99.push_back(atof(fields["p99_ns"].c_str()));
+        records++;
+    }
+    return records;
+}
+
+// Continued fraction of the regularized incomplete beta function I_x(a, b) (modified Lentz)
+static double BetaFraction(double a, double b, double x) {
+    const double kTiny = 1e-300;
+    double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+    if (fabs(d) < kTiny) d = kTiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m <= 300; m++) {
+        double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        if (fabs(d) < kTiny) d = kTiny;
+        c = 1.0 + aa / c;
+        if (fabs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        if (fabs(d) < kTiny) d = kTiny;
+        c = 1.0 + aa / c;
+        if (fabs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        double step = d * c;
+        h *= step;
+        if (fabs(step - 1.0) < 1e-14) break;
+    }
+    return h;
+}
+
+static double IncompleteBeta(double a, double b, double x) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x));
+    // 수렴이 빠른 쪽의 전개를 쓴다
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * BetaFraction(a, b, x) / a;
+    }
+    return 1.0 - front * BetaFraction(b, a, 1.0 - x) / b;
+}
+
+// StudentQuantile function: t such that P(|T| <= t) = 'confidence' for 'df' degrees of freedom (bisection on the CDF).
+static double StudentQuantile(double confidence, double df) {
+    double lo = 0, hi = 1e3;
+    for (int i = 0; i < 200; i++) {
+        double t = (lo + hi) / 2;
+        double outside = IncompleteBeta(df / 2, 0.5, df / (df + t * t)); // P(|T| > t)
+        if (1.0 - outside < confidence) {
+            lo = t;
+        } else {
+            hi = t;
+        }
+    }
+    return (lo + hi) / 2;
+}
+
+static void MeanVariance(const std::vector<double>& x, double& mean, double& variance) {
+    mean = 0;
+    for (double v : x) mean += v;
+    mean /= x.size();
+    variance = 0;
+    for (double v : x) variance += (v - mean) * (v - mean);
+    variance = x.size() > 1 ? variance / (x.size() - 1) : 0;
+}
+
+// Compare function: Prints one metric of one group and returns true if it regressed.
+// 'higher_is_better' is true for throughput and false for latency.
+static bool Compare(const char* metric, const std::vector<double>& base, const std::vector<double>& next,
+                    bool higher_is_better, double confidence, double threshold) {
+    double base_mean, base_var, next_mean, next_var;
+    MeanVariance(base, base_mean, base_var);
+    MeanVariance(next, next_mean, next_var);
+    printf("  %-8s %12.4g -> %12.4g", metric, base_mean, next_mean);
+    if (base.size() < 2 || next.size() < 2 || base_mean == 0) {
+        printf("   (needs 2+ trials on each side)\n");
+        return false;
+    }
+
+    // Welch: 두 쪽의 분산이 달라도 되는 평균 차이의 신뢰구간 (Welch–Satterthwaite 자유도)
+    double sb = base_var / base.size(), sn = next_var / next.size();
+    double se = sqrt(sb + sn);
+    double diff = next_mean - base_mean;
+    double lo = diff, hi = diff;
+    if (se > 0) {
+        double df = (sb + sn) * (sb + sn) / (sb * sb / (base.size() - 1) + sn * sn / (next.size() - 1));
+        double t = StudentQuantile(confidence, df);
+        lo = diff - t * se;
+        hi = diff + t * se;
+    }
+    double change = diff / base_mean;
+    printf("  %+7.2lf%% [%+7.2lf%%, %+7.2lf%%]", change * 100, lo / base_mean * 100, hi / base_mean * 100);
+
+    bool significant = lo > 0 || hi < 0;
+    bool worse = higher_is_better ? change < 0 : change > 0;
+    bool regression = significant && worse && fabs(change) >= threshold;
+    if (regression) {
+        printf("  REGRESSION\n");
+    } else if (significant && fabs(change) >= threshold) {
+        printf("  improvement\n");
+    } else {
+        printf("\n");
+    }
+    return regression;
+}
+
+static void printUsage(const char* programName) {
+    std::cerr << "\nUsage: " << programName << " [Baseline results] [Candidate results] [--confidence=0.95] [--threshold=0.02]\n\n"
+              << "Both files are written by ./bench --out=FILE (run with --trials=N, N >= 2, or several times).\n"
+              << "A metric is flagged as a REGRESSION when the confidence interval of the change of its mean\n"
+              << "excludes zero and the change is worse than the threshold (a fraction of the baseline mean).\n"
+              << "Exits with 1 if any regression was found.\n";
+}
+
+int main(int argc, char *argv[]) {
+    double confidence = 0.95;
+    double threshold = 0.02;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--confidence=", 13) == 0) {
+            confidence = atof(argv[i] + 13);
+        } else if (strncmp(argv[i], "--threshold=", 12) == 0) {
+            threshold = atof(argv[i] + 12);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.size() != 2 || confidence <= 0 || confidence >= 1 || threshold < 0) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, Samples> base, next;
+    long base_records = Load(files[0], base);
+    long next_records = Load(files[1], next);
+    if (base_records < 0 || next_records < 0) {
+        perror(base_records < 0 ? files[0] : files[1]);
+        return 2;
+    }
+    printf("Baseline  %s: %ld records\nCandidate %s: %ld records\n", files[0], base_records, files[1], next_records);
+    printf("%.0lf%% confidence intervals (Welch), threshold %.1lf%%\n", confidence * 100, threshold * 100);
+
+    int compared = 0, regressions = 0;
+    for (const auto& group : base) {
+        auto match = next.find(group.first);
+        if (match == next.end()) {
+            continue;
+        }
+        const Samples& b = group.second;
+        const Samples& n = match->second;
+        printf("\n%s  (n = %zu vs %zu)\n", group.first.c_str(), b.mops.size(), n.mops.size());
+        regressions += Compare("Mops/s", b.mops, n.mops, true, confidence, threshold);
+        regressions += Compare("p50 ns", b.p50, n.p50, false, confidence, threshold);
+        regressions += Compare("p99 ns", b.p99, n.p99, false, confidence, threshold);
+        compared++;
+    }
+    printf("\n%d groups compared, %d regression%s\n", compared, regressions, regressions == 1 ? "" : "s");
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// Log-bucketed latency histogram in the style of HdrHistogram.
+//
+// Values below 2^kSubBucketBits are counted exactly. Larger values fall into one of 2^kSubBucketBits
+// linear sub-buckets per power of two, so a recorded value is known to within 1 / 2^kSubBucketBits
+// (< 1%) of itself over the whole uint64 range, with a fixed table of counters and O(1) Record.
+// Percentile reports the highest value of the bucket it lands in, Max is exact.
+class LatencyHistogram {
+   public:
+    LatencyHistogram() : counts(kBuckets, 0), total(0), max_value(0), sum(0) {}
+
+    void Record(uint64_t value) {
+        counts[BucketOf(value)]++;
+        total++;
+        sum += value;
+        if (value > max_value) max_value = value;
+    }
+
+    // Merge function: Adds the counts of 'other' (histograms of several threads / runs).
+    void Merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBuckets; i++) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        sum += other.sum;
+        if (other.max_value > max_value) max_value = other.max_value;
+    }
+
+    void Reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = sum = max_value = 0;
+    }
+
+    // Percentile function: Smallest recorded bucket value that 'p' percent of the values do not exceed.
+    uint64_t Percentile(double p) const {
+        if (total == 0) {
+            return 0;
+        }
+        // 1. 앞에서부터 누적해 p%에 해당하는 순위가 들어 있는 bucket을 찾는다
+        uint64_t rank = (uint64_t)(p / 100.0 * total + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                // 2. bucket의 가장 큰 값 (단, 실제 최댓값보다 크게 보고하지 않는다)
+                uint64_t highest = HighestOf(i);
+                return highest < max_value ? highest : max_value;
+            }
+        }
+        return max_value;
+    }
+
+    uint64_t Count() const { return total; }
+    uint64_t Max() const { return max_value; }
+    double Mean() const { return total ? (double)sum / total : 0.0; }
+
+   private:
+    static constexpr int kSubBucketBits = 7;
+    static constexpr uint64_t kSubBuckets = 1ull << kSubBucketBits;
+    // Exact buckets for [0, kSubBuckets), then kSubBuckets per power of two up to 2^64
+    static constexpr size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static size_t BucketOf(uint64_t value) {
+        if (value < kSubBuckets) {
+            return (size_t)value;
+        }
+        // 가장 높은 비트 아래 kSubBucketBits 비트가 power-of-two 구간 안의 위치
+        int shift = (63 - __builtin_clzll(value)) - kSubBucketBits;
+        return (size_t)(shift + 1) * kSubBuckets + (size_t)((value >> shift) - kSubBuckets);
+    }
+
+    static uint64_t HighestOf(size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        int shift = (int)(bucket / kSubBuckets) - 1;
+        uint64_t lowest = (bucket % kSubBuckets + kSubBuckets) << shift;
+        return lowest + ((1ull << shift) - 1);
+    }
+
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t max_value;
+    uint64_t sum;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Hardware performance counters of the calling thread (perf_event_open), user space only.
+//
+// Each event is opened on its own, so a machine without one of them (a VM without a PMU, an older
+// CPU, perf_event_paranoid > 2) still gets the others; an event that cannot be opened reads as
+// unavailable. When the kernel multiplexes the counters, the values are scaled by the time each one
+// actually ran.
+class PerfCounters {
+   public:
+    enum Event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, DTLB_MISSES, BRANCH_MISSES, EVENTS };
+
+    // Counter values of one Start/Stop interval
+    struct Sample {
+        double value[EVENTS];
+        bool valid[EVENTS];
+    };
+
+    PerfCounters() : open_error(0) {
+        static const struct { uint32_t type; uint64_t config; } kEvents[EVENTS] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_L1D)},
+            {PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_LL)},
+            {PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_DTLB)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        };
+        for (int e = 0; e < EVENTS; e++) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = kEvents[e].type;
+            attr.config = kEvents[e].config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            if (fds[e] < 0 && open_error == 0) {
+                open_error = errno;
+            }
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool Available(Event e) const { return fds[e] >= 0; }
+    bool AnyAvailable() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+    // errno of the first event that could not be opened (0 if all were)
+    int OpenError() const { return open_error; }
+
+    void Start() {
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    // Stop function: Stops the counters and returns what they counted since Start().
+    Sample Stop() {
+        Sample sample;
+        for (int e = 0; e < EVENTS; e++) {
+            sample.value[e] = 0;
+            sample.valid[e] = false;
+            if (fds[e] < 0) continue;
+            ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t data[3]; // value, time enabled, time running
+            if (read(fds[e], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+            // 다중화로 일부 시간만 셌다면 켜져 있던 시간 전체로 환산
+            sample.value[e] = data[2] < data[1] ? (double)data[0] * data[1] / data[2] : (double)data[0];
+            sample.valid[e] = true;
+        }
+        return sample;
+    }
+
+    static const char* Name(Event e) {
+        static const char* kNames[EVENTS] = {"cycles", "instructions", "L1D misses", "LLC misses", "dTLB misses", "branch misses"};
+        return kNames[e];
+    }
+
+   private:
+    static uint64_t CacheEvent(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    int fds[EVENTS];
+    int open_error;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include "perf_counters.h"
+
+// Machine-readable benchmark results.
+//
+// Every measured phase becomes one flat record: what was run (workload, structure, phase, counts,
+// extra argument, trial), what it measured (throughput, latency percentiles, allocations and
+// hardware counters per operation) and where (host, CPU, kernel, compiler, start time). A file
+// ending in ".csv" gets CSV with a header row; any other file gets JSON lines, one object per record.
+// Records are appended, so repeated runs accumulate in one file for the comparator (compare.cc).
+struct ResultRecord {
+    std::string workload;  // e.g. "Uniform", "YCSB A", "Open-Loop"
+    std::string structure; // e.g. "SkipList"
+    std::string phase;     // e.g. "Insert", "Load 50%"
+    long write = 0;
+    long read = 0;
+    std::string extra; // 4th argument of the driver (threads, YCSB mix, trace file), may be empty
+    int trial = 0;
+
+    uint64_t ops = 0;
+    double seconds = 0;
+    uint64_t p50 = 0, p99 = 0, p999 = 0, max = 0; // ns
+    double mean = 0;                              // ns
+    uint64_t result = 0;
+    double allocs_per_op = -1; // < 0 if not measured
+    double keygen_mops = -1;   // Rate of the key generation done before the phase, < 0 if keys were generated inside it
+    double counters[PerfCounters::EVENTS] = {};
+    bool counter_valid[PerfCounters::EVENTS] = {};
+};
+
+// ResultWriter: Appends ResultRecords to a JSON lines or CSV file.
+class ResultWriter {
+   public:
+    ResultWriter() : file(nullptr), csv(false) {}
+    ~ResultWriter() {
+        if (file) fclose(file);
+    }
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Open function: Opens 'path' for appending and collects the machine description. Returns false on an I/O error.
+    bool Open(const char* path) {
+        size_t length = strlen(path);
+        csv = length >= 4 && strcmp(path + length - 4, ".csv") == 0;
+        struct stat st;
+        bool fresh = stat(path, &st) != 0 || st.st_size == 0;
+        file = fopen(path, "a");
+        if (!file) {
+            return false;
+        }
+        DescribeMachine();
+        if (csv && fresh) {
+            WriteCsvHeader();
+        }
+        return true;
+    }
+
+    bool Enabled() const { return file != nullptr; }
+
+    void Write(const ResultRecord& r) {
+        if (!file) {
+            return;
+        }
+        double mops = r.seconds > 0 ? r.ops / r.seconds * 1e-6 : 0.0;
+        if (csv) {
+            Field(r.workload); Field(r.structure); Field(r.phase);
+            fprintf(file, "%ld,%ld,", r.write, r.read);
+            Field(r.extra);
+            fprintf(file, "%d,%lu,%.9g,%.6g,%lu,%lu,%lu,%lu,%.6g,%lu,", r.trial, (unsigned long)r.ops, r.seconds, mops,
+                    (unsigned long)r.p50, (unsigned long)r.p99, (unsigned long)r.p999, (unsigned long)r.max, r.mean,
+                    (unsigned long)r.result);
+            if (r.allocs_per_op >= 0) fprintf(file, "%.6g", r.allocs_per_op);
+            fputc(',', file);
+            if (r.keygen_mops >= 0) fprintf(file, "%.6g", r.keygen_mops);
+            for (int e = 0; e < PerfCounters::EVENTS; e++) {
+                fputc(',', file);
+                if (r.counter_valid[e]) fprintf(file, "%.6g", r.counters[e]);
+            }
+            for (const std::string& m : {host, cpu, cpus, kernel, compiler, started}) {
+                fputc(',', file);
+                Field(m, false);
+            }
+            fputc('\n', file);
+        } else {
+            fputc('{', file);
+            Pair("workload", r.workload); Pair("structure", r.structure); Pair("phase", r.phase);
+            fprintf(file, "\"write\":%ld,\"read\":%ld,", r.write, r.read);
+            Pair("extra", r.extra);
+            fprintf(file, "\"trial\":%d,\"ops\":%lu,\"seconds\":%.9g,\"mops\":%.6g,\"p50_ns\":%lu,\"p99_ns\":%lu,\"p999_ns\":%lu,\"max_ns\":%lu,\"mean_ns\":%.6g,\"result\":%lu,",
+                    r.trial, (unsigned long)r.ops, r.seconds, mops, (unsigned long)r.p50, (unsigned long)r.p99,
+                    (unsigned long)r.p999, (unsigned long)r.max, r.mean, (unsigned long)r.result);
+            if (r.allocs_per_op >= 0) {
+                fprintf(file, "\"allocs_per_op\":%.6g,", r.allocs_per_op);
+            } else {
+                fprintf(file, "\"allocs_per_op\":null,");
+            }
+            if (r.keygen_mops >= 0) {
+                fprintf(file, "\"keygen_mops\":%.6g,", r.keygen_mops);
+            } else {
+                fprintf(file, "\"keygen_mops\":null,");
+            }
+            for (int e = 0; e < PerfCounters::EVENTS; e++) {
+                if (r.counter_valid[e]) {
+                    fprintf(file, "\"%s_per_op\":%.6g,", kColumns[e], r.counters[e]);
+                } else {
+                    fprintf(file, "\"%s_per_op\":null,", kColumns[e]);
+                }
+            }
+            Pair("host", host); Pair("cpu", cpu); Pair("cpus", cpus); Pair("kernel", kernel); Pair("compiler", compiler);
+            Pair("started", started, false);
+            fputs("}\n", file);
+        }
+        fflush(file);
+    }
+
+   private:
+    // Column names of PerfCounters::Event, without spaces
+    static constexpr const char* kColumns[PerfCounters::EVENTS] = {"cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses", "branch_misses"};
+
+    void DescribeMachine() {
+        char name[256] = "";
+        gethostname(name, sizeof(name) - 1);
+        host = name;
+        // /proc/cpuinfo의 첫 "model name" 줄
+        cpu.clear();
+        if (FILE* info = fopen("/proc/cpuinfo", "r")) {
+            char line[512];
+            while (fgets(line, sizeof(line), info)) {
+                if (strncmp(line, "model name", 10) == 0) {
+                    const char* value = strchr(line, ':');
+                    cpu = value ? value + 1 : "";
+                    while (!cpu.empty() && (cpu.back() == '\n' || cpu.back() == ' ')) cpu.pop_back();
+                    while (!cpu.empty() && cpu.front() == ' ') cpu.erase(0, 1);
+                    break;
+                }
+            }
+            fclose(info);
+        }
+        cpus = std::to_string(std::thread::hardware_concurrency());
+        struct utsname uts;
+        kernel = uname(&uts) == 0 ? std::string(uts.sysname) + " " + uts.release : "";
+        compiler = __VERSION__;
+        char stamp[32];
+        time_t now = time(nullptr);
+        strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+        started = stamp;
+    }
+
+    void WriteCsvHeader() {
+        fputs("workload,structure,phase,write,read,extra,trial,ops,seconds,mops,p50_ns,p99_ns,p999_ns,max_ns,mean_ns,result,allocs_per_op,keygen_mops", file);
+        for (const char* column : kColumns) {
+            fprintf(file, ",%s_per_op", column);
+        }
+        fputs(",host,cpu,cpus,kernel,compiler,started\n", file);
+    }
+
+    // CSV field, quoted (with doubled quotes) when it contains a separator or a quote
+    void Field(const std::string& value, bool comma = true) {
+        if (value.find_first_of(",\"\n") == std::string::npos) {
+            fputs(value.c_str(), file);
+        } else {
+            fputc('"', file);
+            for (char c : value) {
+                if (c == '"') fputc('"', file);
+                fputc(c, file);
+            }
+            fputc('"', file);
+        }
+        if (comma) fputc(',', file);
+    }
+
+    // JSON "name":"value" pair with the string escaped
+    void Pair(const char* name, const std::string& value, bool comma = true) {
+        fprintf(file, "\"%s\":\"", name);
+        for (unsigned char c : value) {
+            if (c == '"' || c == '\\') {
+                fputc('\\', file);
+                fputc(c, file);
+            } else if (c < 0x20) {
+                fprintf(file, "\\u%04x", c);
+            } else {
+                fputc(c, file);
+            }
+        }
+        fputc('"', file);
+        if (comma) fputc(',', file);
+    }
+
+    FILE* file;
+    bool csv;
+    std::string host, cpu, cpus, kernel, compiler, started;
+};
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Binary operation trace.
+//
+// A trace is a 32-byte header followed by one record per operation:
+//   [op: 1 byte] [zigzag varint: key - previous key] [varint: scan length, scans only]
+// Keys are delta-encoded against the previous record, so a trace of nearby keys costs 2-3 bytes per
+// operation. TraceWriter buffers records in memory and writes the file on Close(); TraceReader maps
+// the file read-only and decodes records in place, so replay does no I/O and no text parsing.
+enum TraceOp : uint8_t { TRACE_INSERT = 0, TRACE_CONTAINS = 1, TRACE_DELETE = 2, TRACE_SCAN = 3 };
+
+struct TraceRecord {
+    TraceOp op;
+    uint32_t scan_length; // TRACE_SCAN only
+    uint64_t key;
+};
+
+struct TraceHeader {
+    char magic[8];   // "IDXTRC01"
+    uint64_t ops;    // Number of records
+    uint64_t bytes;  // Size of the records after the header
+    uint64_t reserved;
+};
+
+static const char kTraceMagic[8] = {'I', 'D', 'X', 'T', 'R', 'C', '0', '1'};
+
+// TraceWriter: Records operations and writes them as a trace file.
+class TraceWriter {
+   public:
+    TraceWriter() : prev(0), ops(0) {}
+
+    void Append(TraceOp op, uint64_t key, uint32_t scan_length = 0) {
+        buffer.push_back(op);
+        // 이전 key와의 차이를 zigzag로 부호 없는 수로 바꿔 varint로
+        int64_t delta = (int64_t)(key - prev);
+        PutVarint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+        if (op == TRACE_SCAN) {
+            PutVarint(scan_length);
+        }
+        prev = key;
+        ops++;
+    }
+
+    // Close function: Writes the header and the records to 'path'. Returns false on an I/O error.
+    bool Close(const char* path) {
+        TraceHeader header;
+        memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+        header.ops = ops;
+        header.bytes = buffer.size();
+        header.reserved = 0;
+        FILE* file = fopen(path, "wb");
+        if (!file) {
+            return false;
+        }
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  (buffer.empty() || fwrite(buffer.data(), buffer.size(), 1, file) == 1);
+        return fclose(file) == 0 && ok;
+    }
+
+    uint64_t Ops() const { return ops; }
+    size_t Bytes() const { return buffer.size(); }
+
+   private:
+    void PutVarint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back((uint8_t)value);
+    }
+
+    std::vector<uint8_t> buffer;
+    uint64_t prev;
+    uint64_t ops;
+};
+
+// TraceReader: Maps a trace file; Cursor decodes its records in order (one cursor per thread).
+class TraceReader {
+   public:
+    TraceReader() : base(nullptr), size(0), records(nullptr), header() {}
+    ~TraceReader() {
+        if (base) munmap(base, size);
+    }
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    // Open function: Maps 'path' and checks its header. Returns false if it is not a whole trace file.
+    bool Open(const char* path) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+            close(fd);
+            return false;
+        }
+        size = st.st_size;
+        base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            return false;
+        }
+        madvise(base, size, MADV_SEQUENTIAL);
+        memcpy(&header, base, sizeof(header));
+        records = (const uint8_t*)base + sizeof(TraceHeader);
+        return memcmp(header.magic, kTraceMagic, sizeof(header.magic)) == 0 && sizeof(TraceHeader) + header.bytes <= size;
+    }
+
+    uint64_t Ops() const { return header.ops; }
+    uint64_t Bytes() const { return header.bytes; }
+
+    class Cursor {
+       public:
+        Cursor(const uint8_t* p, const uint8_t* end) : p(p), end(end), prev(0) {}
+
+        // Next function: Decodes the next record; false at the end of the trace.
+        bool Next(TraceRecord& record) {
+            if (p >= end) {
+                return false;
+            }
+            record.op = (TraceOp)(*p++ & 3);
+            uint64_t zigzag = GetVarint();
+            prev += (uint64_t)((int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1));
+            record.key = prev;
+            record.scan_length = record.op == TRACE_SCAN ? (uint32_t)GetVarint() : 0;
+            return true;
+        }
+
+       private:
+        uint64_t GetVarint() {
+            uint64_t value = 0;
+            for (int shift = 0; p < end && shift < 64; shift += 7) {
+                uint8_t byte = *p++;
+                value |= (uint64_t)(byte & 0x7f) << shift;
+                if (byte < 0x80) break;
+            }
+            return value;
+        }
+
+        const uint8_t* p;
+        const uint8_t* end;
+        uint64_t prev;
+    };
+
+    Cursor Begin() const { return Cursor(records, records + header.bytes); }
+
+   private:
+    void* base;
+    size_t size;
+    const uint8_t* records;
+    TraceHeader header;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Array of read/write sizes to test
+sizes=(10000 1000000)
+
+# Loop through each size
+for size in "${sizes[@]}"; do
+    echo "Testing with read/write size: $size"
+
+    # Loop through options 0 to 14 (see ./bench for what each one runs)
+    for option in {0..14}; do
+        echo "Running with option: $option"
+
+        # Run the program with a timeout of 240 seconds (four structures per option)
+        timeout 240s ./bench $size $size $option
+
+        # Check the exit status of the timeout command
+        if [ $? -eq 124 ]; then
+            echo "Test with size $size and option $option timed out after 240 seconds. Moving to next test."
+        else
+            echo "Test with size $size and option $option completed."
+        fi
+    done
+
+    # Record a trace (option 15) and replay it on one and on two threads (option 16)
+    trace=$(mktemp)
+    timeout 240s ./bench $size $size 15 $trace && timeout 240s ./bench 0 0 16 $trace && timeout 240s ./bench 0 0 16 $trace 2
+    echo "Trace test with size $size completed (exit status $?)."
+    rm -f $trace
+
+    # Heap footprint after loading $size keys (option 17)
+    timeout 240s ./bench $size 0 17
+    echo "Memory test with size $size completed (exit status $?)."
+
+    # Structured results of repeated trials (option 2), compared against themselves with ./compare
+    results=$(mktemp --suffix=.json)
+    timeout 240s ./bench $size $size 2 --trials=3 --out=$results > /dev/null && ./compare $results $results > /dev/null
+    echo "Results test with size $size completed (exit status $?)."
+    rm -f $results
+done
+
+echo "All tests completed."
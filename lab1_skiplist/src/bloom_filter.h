@@ -0,0 +1,103 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <type_traits>
+
+// Cache-line blocked Bloom filter used in front of SkipList / Bplustree point operations.
+//
+// The filter is an array of 64-byte blocks. A key hashes to one block and sets kProbes bits inside it,
+// so both Add and MayContain touch a single cache line. A definite "no" lets Contains / Delete return
+// without descending the index; a "maybe" falls through to the normal path, so false positives only cost time.
+//
+// Bits cannot be cleared, so deleted keys stay as false positives until the owner rebuilds the filter.
+// Full() turns true once more keys were added than it was sized for; the owner then rebuilds it from
+// the keys it actually holds with a larger capacity.
+template<typename Key>
+class BlockedBloomFilter {
+   public:
+    static const int kProbes = 6; // Bits set per key; about 1% false positives at 10 bits per key
+
+    BlockedBloomFilter(size_t expected_keys, int bits_per_key = 10);
+
+    // Add function: Records a key.
+    void Add(const Key& key);
+
+    // MayContain function: Returns false only if the key was never added.
+    bool MayContain(const Key& key) const;
+
+    bool Full() const { return count > capacity; }
+    size_t Count() const { return count; }
+    size_t Capacity() const { return capacity; }
+    size_t MemoryBytes() const { return sizeof(*this) + blocks.capacity() * sizeof(Block); }
+
+   private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    static uint64_t Hash(const Key& key) {
+        uint64_t h;
+        if constexpr (std::is_integral<Key>::value) {
+            h = (uint64_t)key;
+        } else {
+            h = std::hash<Key>()(key);
+        }
+        // murmur3 fmix64
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Block of 'h': the upper 32 bits scaled to the block count (no modulo)
+    size_t BlockOf(uint64_t h) const { return (size_t)(((h >> 32) * (uint64_t)blocks.size()) >> 32); }
+
+    std::vector<Block> blocks;
+    size_t capacity; // Keys the filter was sized for
+    size_t count;    // Keys added so far
+};
+
+template<typename Key>
+BlockedBloomFilter<Key>::BlockedBloomFilter(size_t expected_keys, int bits_per_key)
+    : capacity(expected_keys), count(0) {
+    size_t bits = expected_keys * bits_per_key;
+    size_t n = (bits + 511) / 512;
+    blocks.assign(n > 0 ? n : 1, Block{});
+}
+
+template<typename Key>
+void BlockedBloomFilter<Key>::Add(const Key& key) {
+    uint64_t h = Hash(key);
+    Block& block = blocks[BlockOf(h)];
+    // 아래 32비트에서 9비트씩 두 값을 만들어 double hashing으로 블록 안의 위치를 고른다
+    uint32_t h1 = (uint32_t)h;
+    uint32_t h2 = (h1 >> 16) | 1;
+    for (int i = 0; i < kProbes; i++) {
+        uint32_t bit = (h1 + i * h2) & 511;
+        block.words[bit >> 6] |= 1ull << (bit & 63);
+    }
+    count++;
+}
+
+template<typename Key>
+bool BlockedBloomFilter<Key>::MayContain(const Key& key) const {
+    uint64_t h = Hash(key);
+    const Block& block = blocks[BlockOf(h)];
+    uint32_t h1 = (uint32_t)h;
+    uint32_t h2 = (h1 >> 16) | 1;
+    for (int i = 0; i < kProbes; i++) {
+        uint32_t bit = (h1 + i * h2) & 511;
+        if (!(block.words[bit >> 6] & (1ull << (bit & 63)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef FLAT_HASH_SET_H
+#define FLAT_HASH_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <type_traits>
+#include <emmintrin.h>
+
+// Open-addressing hash set for 8-byte integer keys, used as the point-lookup side of HybridIndex.
+//
+// Slots are grouped by 4 (one 32-byte group, two per cache line). A key hashes to a group and probes
+// groups linearly; each group is compared against the key and against the empty marker with SSE2,
+// so one probe step checks 4 slots without branches. Deletes leave a tombstone; the table is rebuilt
+// (twice as large if needed) once live keys plus tombstones pass 3/4 of the slots.
+//
+// The two largest key values are the empty / tombstone markers; if they are inserted as real keys
+// they are kept in flags instead of the table.
+template<typename Key>
+class FlatHashSet {
+    static_assert(std::is_integral<Key>::value && sizeof(Key) == 8, "FlatHashSet needs 8-byte integer keys");
+
+   public:
+    explicit FlatHashSet(size_t expected_keys = 16);
+
+    // Insert function: Returns false if the key was already present.
+    bool Insert(const Key& key);
+    // Erase function: Returns false if the key was not present.
+    bool Erase(const Key& key);
+    bool Contains(const Key& key) const;
+
+    size_t size() const { return count + has_empty_key + has_tombstone_key; }
+    size_t MemoryBytes() const { return sizeof(*this) + groups.capacity() * sizeof(Group); }
+
+   private:
+    static const size_t kGroupSlots = 4;
+    static constexpr Key kEmpty = std::numeric_limits<Key>::max();
+    static constexpr Key kTombstone = std::numeric_limits<Key>::max() - 1;
+
+    struct alignas(32) Group {
+        Key slots[kGroupSlots];
+    };
+
+    // Bit i is set if slot i of 'group' equals 'key' (SSE2 64-bit compare from two 32-bit compares)
+    static unsigned Match(const Group& group, Key key) {
+        const __m128i k = _mm_set1_epi64x((long long)key);
+        __m128i lo = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)group.slots), k);
+        __m128i hi = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(group.slots + 2)), k);
+        lo = _mm_and_si128(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+        hi = _mm_and_si128(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_movemask_pd(_mm_castsi128_pd(lo)) | (_mm_movemask_pd(_mm_castsi128_pd(hi)) << 2);
+    }
+
+    size_t GroupOf(const Key& key) const {
+        uint64_t h = (uint64_t)key * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h >> shift);
+    }
+
+    // Re-inserts every live key into a table of 'group_count' groups (a power of two)
+    void Rehash(size_t group_count);
+
+    std::vector<Group> groups;
+    int shift;           // 64 - log2(groups.size())
+    size_t count;        // Live keys in the table
+    size_t tombstones;   // Deleted slots not yet reused
+    bool has_empty_key;
+    bool has_tombstone_key;
+};
+
+template<typename Key>
+FlatHashSet<Key>::FlatHashSet(size_t expected_keys)
+    : count(0), tombstones(0), has_empty_key(false), has_tombstone_key(false) {
+    size_t group_count = 2; // shift는 64보다 작아야 한다
+    while (group_count * kGroupSlots * 3 / 4 < expected_keys) {
+        group_count <<= 1;
+    }
+    Rehash(group_count);
+}
+
+template<typename Key>
+void FlatHashSet<Key>::Rehash(size_t group_count) {
+    std::vector<Group> old;
+    old.swap(groups);
+    Group empty;
+    for (size_t i = 0; i < kGroupSlots; i++) {
+        empty.slots[i] = kEmpty;
+    }
+    groups.assign(group_count, empty);
+    shift = 64;
+    for (size_t n = group_count; n > 1; n >>= 1) {
+        shift--;
+    }
+    count = 0;
+    tombstones = 0;
+
+    for (const Group& group : old) {
+        for (Key key : group.slots) {
+            if (key == kEmpty || key == kTombstone) continue;
+            // 새 테이블에는 중복도 tombstone도 없으므로 첫 빈 슬롯에 바로 넣는다
+            for (size_t g = GroupOf(key);; g = (g + 1) & (groups.size() - 1)) {
+                unsigned empty_slots = Match(groups[g], kEmpty);
+                if (empty_slots) {
+                    groups[g].slots[__builtin_ctz(empty_slots)] = key;
+                    count++;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+template<typename Key>
+bool FlatHashSet<Key>::Contains(const Key& key) const {
+    if (key == kEmpty) return has_empty_key;
+    if (key == kTombstone) return has_tombstone_key;
+
+    for (size_t g = GroupOf(key);; g = (g + 1) & (groups.size() - 1)) {
+        const Group& group = groups[g];
+        if (Match(group, key)) {
+            return true;
+        }
+        if (Match(group, kEmpty)) {
+            return false; // 빈 슬롯이 있는 그룹에서 probe가 끝난다
+        }
+    }
+}
+
+template<typename Key>
+bool FlatHashSet<Key>::Insert(const Key& key) {
+    if (key == kEmpty || key == kTombstone) {
+        bool& flag = key == kEmpty ? has_empty_key : has_tombstone_key;
+        bool inserted = !flag;
+        flag = true;
+        return inserted;
+    }
+
+    // 1. 채워진 슬롯(tombstone 포함)이 3/4을 넘으면 다시 만든다
+    //    살아 있는 key만으로 3/8을 넘으면 두 배로 키우고, 아니면 같은 크기로 tombstone만 치운다
+    if ((count + tombstones + 1) * 4 > groups.size() * kGroupSlots * 3) {
+        size_t live_limit = groups.size() * kGroupSlots * 3 / 8;
+        Rehash(count + 1 > live_limit ? groups.size() * 2 : groups.size());
+    }
+
+    // 2. 이미 있는지 확인하면서 처음 만난 tombstone / 빈 슬롯을 기억한다
+    Key* target = nullptr;
+    for (size_t g = GroupOf(key);; g = (g + 1) & (groups.size() - 1)) {
+        Group& group = groups[g];
+        if (Match(group, key)) {
+            return false;
+        }
+        unsigned tomb_slots = Match(group, kTombstone);
+        if (!target && tomb_slots) {
+            target = &group.slots[__builtin_ctz(tomb_slots)];
+        }
+        unsigned empty_slots = Match(group, kEmpty);
+        if (empty_slots) {
+            if (!target) {
+                target = &group.slots[__builtin_ctz(empty_slots)];
+            } else {
+                tombstones--;
+            }
+            break;
+        }
+    }
+    *target = key;
+    count++;
+    return true;
+}
+
+template<typename Key>
+bool FlatHashSet<Key>::Erase(const Key& key) {
+    if (key == kEmpty || key == kTombstone) {
+        bool& flag = key == kEmpty ? has_empty_key : has_tombstone_key;
+        bool erased = flag;
+        flag = false;
+        return erased;
+    }
+
+    for (size_t g = GroupOf(key);; g = (g + 1) & (groups.size() - 1)) {
+        Group& group = groups[g];
+        unsigned match = Match(group, key);
+        if (match) {
+            group.slots[__builtin_ctz(match)] = kTombstone;
+            count--;
+            tombstones++;
+            return true;
+        }
+        if (Match(group, kEmpty)) {
+            return false;
+        }
+    }
+}
+
+#endif
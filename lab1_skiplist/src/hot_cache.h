@@ -0,0 +1,128 @@
+#ifndef HOT_CACHE_H
+#define HOT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <type_traits>
+
+// Small direct-mapped cache of point lookup results, placed in front of SkipList / Bplustree.
+//
+// Every slot holds one key with a presence state (present / absent) and a 2-bit use counter.
+// A hit bumps the counter; a miss that maps onto a slot with a non-zero counter only decrements it
+// (CLOCK-style second chance with up to kMaxUses chances) instead of evicting, so a hot key survives
+// a stream of cold misses and uniform lookups do not keep churning the table.
+// The default 4096 slots x 16 bytes stay resident in L2.
+//
+// The owning index calls Update() on Insert / Delete and InvalidateRange() on range deletes, so a
+// cached answer is never stale. Like the indexes themselves, the cache is not safe for concurrent use.
+template<typename Key>
+class HotKeyCache {
+   public:
+    explicit HotKeyCache(size_t slots = 4096);
+
+    // Lookup function:
+    // Returns true if 'key' is cached and stores whether it is in the index in 'present'.
+    bool Lookup(const Key& key, bool& present);
+
+    // Admit function:
+    // Caches the result of a lookup that missed.
+    void Admit(const Key& key, bool present);
+
+    // Update function:
+    // Called after the index inserted (present = true) or deleted (present = false) 'key'.
+    void Update(const Key& key, bool present);
+
+    // InvalidateRange function:
+    // Drops every cached key in [lo, hi].
+    void InvalidateRange(const Key& lo, const Key& hi);
+
+    uint64_t Hits() const { return hits; }
+    uint64_t Misses() const { return misses; }
+    double HitRate() const { return hits + misses ? (double)hits / (hits + misses) : 0.0; }
+    void ResetStats() { hits = misses = 0; }
+    size_t MemoryBytes() const { return sizeof(*this) + table.capacity() * sizeof(Slot); }
+
+   private:
+    enum State : uint8_t { EMPTY = 0, PRESENT = 1, ABSENT = 2 };
+    static const uint8_t kMaxUses = 3;
+
+    struct Slot {
+        Key key;
+        State state;
+        uint8_t uses; // Hits not yet paid back by colliding misses (saturates at kMaxUses)
+    };
+
+    size_t SlotOf(const Key& key) const {
+        uint64_t h;
+        if constexpr (std::is_integral<Key>::value) {
+            h = (uint64_t)key * 0x9E3779B97F4A7C15ull; // Fibonacci hashing, the high bits are well mixed
+        } else {
+            h = std::hash<Key>()(key) * 0x9E3779B97F4A7C15ull;
+        }
+        return h >> shift;
+    }
+
+    std::vector<Slot> table;
+    int shift; // 64 - log2(table size)
+    uint64_t hits;
+    uint64_t misses;
+};
+
+template<typename Key>
+HotKeyCache<Key>::HotKeyCache(size_t slots) : hits(0), misses(0) {
+    // 2의 거듭제곱으로 올림
+    size_t size = 2;
+    int bits = 1;
+    while (size < slots) {
+        size <<= 1;
+        bits++;
+    }
+    table.assign(size, Slot{Key{}, EMPTY, 0});
+    shift = 64 - bits;
+}
+
+template<typename Key>
+bool HotKeyCache<Key>::Lookup(const Key& key, bool& present) {
+    Slot& slot = table[SlotOf(key)];
+    if (slot.state != EMPTY && slot.key == key) {
+        if (slot.uses < kMaxUses) slot.uses++;
+        present = slot.state == PRESENT;
+        hits++;
+        return true;
+    }
+    misses++;
+    return false;
+}
+
+template<typename Key>
+void HotKeyCache<Key>::Admit(const Key& key, bool present) {
+    Slot& slot = table[SlotOf(key)];
+    if (slot.state != EMPTY && slot.uses > 0) {
+        slot.uses--; // 자주 쓰인 key는 쓰인 만큼 기회를 더 준다
+        return;
+    }
+    slot.key = key;
+    slot.state = present ? PRESENT : ABSENT;
+    slot.uses = 0;
+}
+
+template<typename Key>
+void HotKeyCache<Key>::Update(const Key& key, bool present) {
+    Slot& slot = table[SlotOf(key)];
+    if (slot.state != EMPTY && slot.key == key) {
+        slot.state = present ? PRESENT : ABSENT;
+    }
+}
+
+template<typename Key>
+void HotKeyCache<Key>::InvalidateRange(const Key& lo, const Key& hi) {
+    for (Slot& slot : table) {
+        if (slot.state != EMPTY && !(slot.key < lo) && !(hi < slot.key)) {
+            slot.state = EMPTY;
+        }
+    }
+}
+
+#endif
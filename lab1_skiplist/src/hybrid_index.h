@@ -0,0 +1,57 @@
+#ifndef HYBRID_INDEX_H
+#define HYBRID_INDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "flat_hash_set.h"
+
+// Hybrid index: a FlatHashSet answers point operations in O(1) expected time and an ordered
+// index (SkipList or Bplustree) keeps serving Scan. Every update goes to both, so the two always
+// hold the same set of keys; duplicates are ignored, as in SkipList.
+//
+// The hash side costs extra memory (HashBytes()) on top of the ordered index.
+template<typename Key, typename Ordered>
+class HybridIndex {
+   public:
+    // The arguments are forwarded to the ordered index (e.g. max_level or degree).
+    template<typename... Args>
+    explicit HybridIndex(Args&&... args) : ordered(std::forward<Args>(args)...) {}
+
+    // Insert function: Adds the key to both sides. Returns false if it was already present.
+    bool Insert(const Key& key) {
+        if (!hash.Insert(key)) {
+            return false;
+        }
+        ordered.Insert(key);
+        return true;
+    }
+
+    // Contains function: Hash lookup only, the ordered index is not touched.
+    bool Contains(const Key& key) const { return hash.Contains(key); }
+
+    // Delete function: Removes the key from both sides. Absent keys never reach the ordered index.
+    bool Delete(const Key& key) {
+        if (!hash.Erase(key)) {
+            return false;
+        }
+        ordered.Delete(key);
+        return true;
+    }
+
+    // Scan function: Served by the ordered index.
+    std::vector<Key> Scan(const Key& key, const int scan_num) { return ordered.Scan(key, scan_num); }
+
+    size_t size() const { return hash.size(); }
+    size_t HashBytes() const { return hash.MemoryBytes(); }
+
+    // The ordered side, for range operations that have no hybrid wrapper
+    Ordered& OrderedIndex() { return ordered; }
+
+   private:
+    FlatHashSet<Key> hash;
+    Ordered ordered;
+};
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef KV_ENTRY_H
+#define KV_ENTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+// Key-value payloads for SkipList / Bplustree.
+//
+// Both structures are templates over the stored element, so SkipList<KVEntry<K, V>> and
+// Bplustree<KVEntry<K, V>> keep the value next to its key in the node. Entries compare by key only,
+// which lets Upsert overwrite the value in place and Find / Get answer with one lookup.
+template<typename K, typename V>
+struct KVEntry {
+    K key;
+    V value;
+
+    KVEntry() : key(), value() {}
+    // Probe for Find / Contains / Delete / Scan (the value is ignored)
+    explicit KVEntry(const K& key) : key(key), value() {}
+    KVEntry(const K& key, const V& value) : key(key), value(value) {}
+};
+
+template<typename K, typename V>
+bool operator==(const KVEntry<K, V>& a, const KVEntry<K, V>& b) { return a.key == b.key; }
+template<typename K, typename V>
+bool operator!=(const KVEntry<K, V>& a, const KVEntry<K, V>& b) { return !(a.key == b.key); }
+template<typename K, typename V>
+bool operator<(const KVEntry<K, V>& a, const KVEntry<K, V>& b) { return a.key < b.key; }
+template<typename K, typename V>
+bool operator>(const KVEntry<K, V>& a, const KVEntry<K, V>& b) { return b.key < a.key; }
+template<typename K, typename V>
+bool operator<=(const KVEntry<K, V>& a, const KVEntry<K, V>& b) { return !(b.key < a.key); }
+template<typename K, typename V>
+bool operator>=(const KVEntry<K, V>& a, const KVEntry<K, V>& b) { return !(a.key < b.key); }
+
+namespace std {
+template<typename K, typename V>
+struct hash<KVEntry<K, V>> {
+    size_t operator()(const KVEntry<K, V>& entry) const { return std::hash<K>()(entry.key); }
+};
+}
+
+// Append-only log for values too large to keep in a node. Values are copied into fixed-size segments
+// and referenced by offset (segment << 32 | position); a segment is never moved or freed while the log
+// lives, so Read returns a pointer into the log without copying. Overwritten values are not reclaimed.
+class ValueLog {
+   public:
+    explicit ValueLog(size_t segment_size = 1 << 20) : segment_size(segment_size), tail(0), bytes(0) {}
+    ~ValueLog() {
+        for (char* segment : segments) delete[] segment;
+    }
+    ValueLog(const ValueLog&) = delete;
+    ValueLog& operator=(const ValueLog&) = delete;
+
+    // Append function: Copies 'len' bytes to the end of the log and returns their offset.
+    uint64_t Append(const char* data, size_t len) {
+        if (segments.empty() || tail + len > segment_size) {
+            // 세그먼트가 모자라면 새 세그먼트 (세그먼트보다 긴 값은 그 값만의 세그먼트)
+            segments.push_back(new char[len > segment_size ? len : segment_size]);
+            tail = 0;
+        }
+        uint64_t offset = ((uint64_t)(segments.size() - 1) << 32) | tail;
+        memcpy(segments.back() + tail, data, len);
+        tail += len;
+        bytes += len;
+        return offset;
+    }
+
+    const char* Read(uint64_t offset) const { return segments[offset >> 32] + (uint32_t)offset; }
+
+    size_t Bytes() const { return bytes; }
+
+   private:
+    std::vector<char*> segments;
+    size_t segment_size;
+    size_t tail;  // Write position in the last segment
+    size_t bytes; // Bytes appended so far
+};
+
+// Fixed-size value for variable-length payloads: up to kInline bytes are stored in the entry itself,
+// longer payloads go to a ValueLog and only their offset is stored. Node entries therefore keep a
+// bounded size whatever the payload, and small values need no second memory access.
+template<size_t kInline = 16>
+class PackedValue {
+   public:
+    PackedValue() : len(0), offset(0) {}
+
+    // Keeps 'data' inline if it fits, otherwise appends it to 'log'
+    PackedValue(const char* data, uint32_t len, ValueLog& log) : len(len), offset(0) {
+        if (len <= kInline) {
+            memcpy(bytes, data, len);
+        } else {
+            offset = log.Append(data, len);
+        }
+    }
+
+    // Pointer to the payload, in the entry or in 'log' (no copy)
+    const char* Data(const ValueLog& log) const { return len <= kInline ? bytes : log.Read(offset); }
+    uint32_t Size() const { return len; }
+    bool Inline() const { return len <= kInline; }
+
+   private:
+    uint32_t len;
+    union {
+        char bytes[kInline];
+        uint64_t offset;
+    };
+};
+
+#endif
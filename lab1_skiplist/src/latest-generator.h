@@ -1,5 +1,40 @@
+#ifndef LATEST_GENERATOR_H
+#define LATEST_GENERATOR_H
+
+#include "zipf.h"
+
 extern long last_value_latestgen;
 extern long count_basis_latestgen;
 
 void init_latestgen(long init_val);
 long next_value_latestgen();
+
+// Latest generator object on top of ZipfGenerator: the most recently inserted keys are the most popular.
+// Keys are 0 .. count-1 in insertion order (count >= 1); Next() returns count-1-r for a Zipfian rank r, and Grow()
+// is called as keys are inserted so that the newest key becomes the hottest one.
+class LatestGenerator {
+   public:
+    explicit LatestGenerator(uint64_t count, double theta = 0.8, uint64_t seed = 1)
+        : count(count), zipf(0, count ? count - 1 : 0, theta, seed) {}
+
+    void Seed(uint64_t seed) { zipf.Seed(seed); }
+
+    uint64_t Next() {
+        uint64_t rank = zipf.Next();
+        return rank < count ? count - 1 - rank : 0;
+    }
+
+    // Grow function: 'n' more keys were inserted (they are the newest ones).
+    void Grow(uint64_t n = 1) {
+        count += n;
+        zipf.Resize(count);
+    }
+
+    uint64_t Count() const { return count; }
+
+   private:
+    uint64_t count;
+    ZipfGenerator zipf;
+};
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
 #include <stdlib.h>
 #include <cstdint>
 #include <algorithm>
@@ -12,7 +15,15 @@
 #include <mutex>
 #include <vector>
 #include <atomic>
+#include <type_traits>
+
+#include "wal.h"
+#include "hot_cache.h"
+#include "bloom_filter.h"
 
+// Shared with the other labs' headers, so that several indexes can be used in one program
+#ifndef INDEX_KEY_TYPES
+#define INDEX_KEY_TYPES
 typedef std::chrono::high_resolution_clock Clock;
 
 // Key is an 8-byte integer
@@ -27,6 +38,7 @@ int compare_(const Key& a, const Key& b) {
         return 0;
     }
 }
+#endif
 
 template<typename Key>
 class SkipList {
@@ -35,19 +47,79 @@ class SkipList {
 
    public:
     SkipList(int max_level = 16, float probability = 0.5);
+    ~SkipList(); // Frees every node and the optional cache / filter
 
     void Insert(const Key& key); // Insertion function (to be implemented by students)
     bool Contains(const Key& key) const; // Lookup function (to be implemented by students)
     std::vector<Key> Scan(const Key& key, const int scan_num); // Range query function (to be implemented by students)
+
+    // Key-value use (SkipList<KVEntry<K, V>>, kv_entry.h): entries compare by key only, so these work on the whole entry.
+    // Inserts the entry, or overwrites the stored entry with the same key in place. Returns true if it was new.
+    bool Upsert(const Key& key);
+    // Pointer to the stored element equal to 'key' (nullptr if absent), valid until that element is deleted
+    const Key* Find(const Key& key) const;
+    // Calls visit(const Key&) on up to 'scan_num' stored elements from 'key' on, without copying them
+    template<typename Visitor>
+    void ScanVisit(const Key& key, const int scan_num, Visitor visit) const;
     bool Delete(const Key& key) const; // Delete function (to be implemented by students)
     void Print() const;
 
+    // Logs every following Insert/Delete to 'wal' before the list is modified.
+    // The change is durable once the caller's wal->Sync() returns (group commit).
+    void AttachWal(Wal* wal);
+    // Replays the log at 'path' into the list (call before AttachWal). Returns the number of records applied.
+    long Recover(const char* path);
+
+    // Puts a HotKeyCache with 'slots' entries in front of Contains (0 removes it).
+    // Insert/Delete keep the cached answers up to date.
+    void EnableHotCache(size_t slots = 4096);
+    // The front cache, for its hit/miss counters (nullptr if disabled)
+    HotKeyCache<Key>* HotCache() const { return hot_cache; }
+
+    // Puts a blocked Bloom filter with 'bits_per_key' bits per key in front of Contains/Delete (0 removes it).
+    // Definite misses return without walking the list. The filter is rebuilt from the list, twice as large,
+    // whenever more keys were added than it was sized for.
+    void EnableBloomFilter(int bits_per_key = 10);
+    const BlockedBloomFilter<Key>* BloomFilter() const { return bloom; }
+
+    // Memory footprint of the list, by category. Every node is one allocation for the Node and one
+    // for its next[] array; 'allocator_bytes' is what malloc adds to them (chunk header and rounding).
+    struct MemoryStats {
+        size_t nodes;             // Nodes holding a key (the head is not counted)
+        int height;               // Highest level in use
+        double pointers_per_node; // Average level of a node
+        size_t key_bytes;         // Keys
+        size_t pointer_bytes;     // next[] arrays, the head's included
+        size_t header_bytes;      // Rest of the Node structs (vector header, padding)
+        size_t allocator_bytes;   // malloc overhead of the two allocations per node
+        size_t aux_bytes;         // Hot cache and Bloom filter
+        size_t total_bytes;
+    };
+    MemoryStats MemoryUsage() const;
+
    private:
     int RandomLevel(); // Generates a random level for new nodes (to be implemented by students)
+    // Bytes glibc malloc adds to a request of 'bytes' (8-byte header, 16-byte granularity, 32-byte chunks at least)
+    static size_t MallocOverhead(size_t bytes) {
+        if (bytes == 0) return 0;
+        size_t chunk = std::max<size_t>(32, (bytes + 8 + 15) & ~(size_t)15);
+        return chunk - bytes;
+    }
+    void RebuildBloomFilter(); // Re-sizes the Bloom filter to the current key count and refills it
+    // Logs an update to the attached WAL; the log stores integer keys, so other key types are never logged
+    void LogUpdate(WalOp op, const Key& key) const {
+        if constexpr (std::is_integral<Key>::value) {
+            if (wal) wal->Append(op, key);
+        }
+    }
 
     Node* head; // Head node (starting point of the SkipList)
     int max_level; // Maximum level in the SkipList
     float probability; // Probability factor for level increase
+    Wal* wal; // Optional write-ahead log (nullptr if not attached)
+    HotKeyCache<Key>* hot_cache; // Optional front cache for point lookups (nullptr if disabled)
+    BlockedBloomFilter<Key>* bloom; // Optional filter for negative lookups (nullptr if disabled)
+    int bloom_bits_per_key;
 };
 
 // SkipList Node structure
@@ -77,14 +149,57 @@ int SkipList<Key>::RandomLevel() {
 // Constructor for SkipList
 template<typename Key>
 SkipList<Key>::SkipList(int max_level, float probability)
-    : max_level(max_level), probability(probability) {
-        head = new Node(0, max_level);
-        //head에 key value가 0이고 max_level이 max_level인 노드 생성
+    : max_level(max_level), probability(probability), wal(nullptr), hot_cache(nullptr), bloom(nullptr), bloom_bits_per_key(0) {
+        head = new Node(Key{}, max_level);
+        //head에 key value가 Key{}(정수 key면 0)이고 max_level이 max_level인 노드 생성
         head->next = std::vector<Node*>(max_level, nullptr);
         //head의 next에 max_level만큼 노드 배열을 nullptr로 초기화
     // To be implemented by students
 }
 
+// Destructor for SkipList
+template<typename Key>
+SkipList<Key>::~SkipList() {
+    // level 0을 따라가며 head를 포함한 모든 노드를 해제
+    Node* current = head;
+    while (current != nullptr) {
+        Node* next = current->next[0];
+        delete current;
+        current = next;
+    }
+    delete hot_cache;
+    delete bloom;
+}
+
+// MemoryUsage function: Walks level 0 and adds up every node and its pointer array.
+template<typename Key>
+typename SkipList<Key>::MemoryStats SkipList<Key>::MemoryUsage() const {
+    MemoryStats stats = {};
+    size_t pointers = 0;
+    for (const Node* node = head; node != nullptr; node = node->next[0]) {
+        size_t array_bytes = node->next.capacity() * sizeof(Node*);
+        stats.pointer_bytes += array_bytes;
+        stats.header_bytes += sizeof(Node) - sizeof(Key);
+        stats.allocator_bytes += MallocOverhead(sizeof(Node)) + MallocOverhead(array_bytes);
+        if (node != head) {
+            stats.nodes++;
+            stats.key_bytes += sizeof(Key);
+            pointers += node->next.size();
+        }
+    }
+    // head의 가장 높은 non-null 레벨이 리스트의 높이
+    for (int i = max_level - 1; i >= 0; i--) {
+        if (head->next[i] != nullptr) {
+            stats.height = i + 1;
+            break;
+        }
+    }
+    stats.pointers_per_node = stats.nodes ? (double)pointers / stats.nodes : 0.0;
+    stats.aux_bytes = (hot_cache ? hot_cache->MemoryBytes() : 0) + (bloom ? bloom->MemoryBytes() : 0);
+    stats.total_bytes = stats.key_bytes + stats.pointer_bytes + stats.header_bytes + stats.allocator_bytes + stats.aux_bytes;
+    return stats;
+}
+
 // Insert function (inserts a key into SkipList)
 template<typename Key>
 void SkipList<Key>::Insert(const Key& key) {
@@ -106,6 +221,7 @@ void SkipList<Key>::Insert(const Key& key) {
 
     // 키가 존재하지 않을 시 삽입
     if (current == nullptr || current->key != key) {
+        LogUpdate(WAL_INSERT, key); // 리스트를 바꾸기 전에 먼저 로그에 남긴다
         int new_level = RandomLevel();
         Node* new_node = new Node(key, new_level);
 
@@ -114,12 +230,20 @@ void SkipList<Key>::Insert(const Key& key) {
             new_node->next[i] = update[i]->next[i];
             update[i]->next[i] = new_node;
         }
+        if (hot_cache) hot_cache->Update(key, true);
+        if (bloom) {
+            bloom->Add(key);
+            if (bloom->Full()) RebuildBloomFilter();
+        }
     }
 }
 
 // Delete function (removes a key from SkipList)
 template<typename Key>
 bool SkipList<Key>::Delete(const Key& key) const {
+    if (bloom && !bloom->MayContain(key)) {
+        return false; // 한 번도 삽입된 적 없는 key
+    }
     Node* current = head;
     std::vector<Node*> updates(max_level);
 
@@ -135,16 +259,17 @@ bool SkipList<Key>::Delete(const Key& key) const {
     if (current == nullptr || current->key != key) {
         return false;  // 키가 존재하지 않을 시 false 리턴
     }
+    LogUpdate(WAL_DELETE, key); // 리스트를 바꾸기 전에 먼저 로그에 남긴다
 
     //전체 레벨에 있는 노드들을 삭제
     for (int i = 0; i < max_level; i++) {
-        if (updates[i]->next[i] == current) {
-            updates[i]->next[i] = current->next[i];
-        } //update에 저장된 노드들의 다음 노드를 current의 다음 노드로 대체
-        //상위 레벨이 없을 시 올라가지 않는다.
-        if (updates[i]->next[i] == nullptr) break;
+        //current가 없는 상위 레벨에 도달하면 올라가지 않는다.
+        if (updates[i]->next[i] != current) break;
+        updates[i]->next[i] = current->next[i];
+        //update에 저장된 노드들의 다음 노드를 current의 다음 노드로 대체
     }
     delete current;
+    if (hot_cache) hot_cache->Update(key, false);
     return true;
 }
 
@@ -152,6 +277,13 @@ bool SkipList<Key>::Delete(const Key& key) const {
 template<typename Key>
 bool SkipList<Key>::Contains(const Key& key) const {
     // To be implemented by students
+    bool cached;
+    if (hot_cache && hot_cache->Lookup(key, cached)) {
+        return cached; // 자주 찾는 key는 탐색 없이 바로 답한다
+    }
+    if (bloom && !bloom->MayContain(key)) {
+        return false; // 확실히 없는 key는 리스트를 타지 않는다
+    }
         Node* current = head;
 
     //레벨을 따라 진행하며 찾아가는 과정
@@ -161,10 +293,80 @@ bool SkipList<Key>::Contains(const Key& key) const {
         }
     }
     current = current->next[0];
-    if(current != nullptr && current->key == key){
-        return true;
-    } //리스트에 요소가 존재할 시 true 리턴
-    return false; //리스트에 요소가 존재하지 않을 시 false 리턴
+    bool found = current != nullptr && current->key == key;
+    if (hot_cache) hot_cache->Admit(key, found);
+    return found; //리스트에 요소가 존재할 시 true, 아니면 false 리턴
+}
+
+// Upsert function (inserts a key, or overwrites the equal stored key in place)
+template<typename Key>
+bool SkipList<Key>::Upsert(const Key& key) {
+    std::vector<Node*> update(max_level, nullptr);
+    Node* current = head;
+
+    //Insert와 같은 탐색 한 번으로 위치를 찾는다
+    for (int i = max_level - 1; i >= 0; i--) {
+        while (current->next[i] != nullptr && current->next[i]->key < key) {
+            current = current->next[i];
+        }
+        update[i] = current;
+    }
+    current = current->next[0];
+
+    // 이미 있으면 그 노드에서 덮어쓴다 (KVEntry면 value만 바뀐다)
+    if (current != nullptr && current->key == key) {
+        current->key = key;
+        return false;
+    }
+
+    // 새 key만 로그에 남긴다. 로그에 남는 정수 key는 덮어써도 바뀌는 것이 없다
+    LogUpdate(WAL_INSERT, key); // 리스트를 바꾸기 전에 먼저 로그에 남긴다
+
+    int new_level = RandomLevel();
+    Node* new_node = new Node(key, new_level);
+    for (int i = 0; i < new_level; i++) {
+        new_node->next[i] = update[i]->next[i];
+        update[i]->next[i] = new_node;
+    }
+    if (hot_cache) hot_cache->Update(key, true);
+    if (bloom) {
+        bloom->Add(key);
+        if (bloom->Full()) RebuildBloomFilter();
+    }
+    return true;
+}
+
+// Find function (returns the stored element equal to key, or nullptr)
+template<typename Key>
+const Key* SkipList<Key>::Find(const Key& key) const {
+    if (bloom && !bloom->MayContain(key)) {
+        return nullptr;
+    }
+    Node* current = head;
+    for (int i = max_level - 1; i >= 0; i--) {
+        while (current->next[i] != nullptr && current->next[i]->key < key) {
+            current = current->next[i];
+        }
+    }
+    current = current->next[0];
+    return current != nullptr && current->key == key ? &current->key : nullptr;
+}
+
+// Visiting range query (passes the stored elements to visit instead of copying them)
+template<typename Key>
+template<typename Visitor>
+void SkipList<Key>::ScanVisit(const Key& key, const int scan_num, Visitor visit) const {
+    Node* current = head;
+    for (int i = max_level - 1; i >= 0; i--) {
+        while (current->next[i] != nullptr && current->next[i]->key < key) {
+            current = current->next[i];
+        }
+    }
+    current = current->next[0];
+    for (int n = 0; current != nullptr && n < scan_num; n++) {
+        visit(static_cast<const Key&>(current->key));
+        current = current->next[0];
+    }
 }
 
 // Range query function (retrieves scan_num keys starting from key)
@@ -191,6 +393,61 @@ std::vector<Key> SkipList<Key>::Scan(const Key& key, const int scan_num) {
     return result;
 }
 
+// Start logging updates to the given write-ahead log
+template<typename Key>
+void SkipList<Key>::AttachWal(Wal* wal) {
+    static_assert(std::is_integral<Key>::value, "the WAL stores integer keys");
+    this->wal = wal;
+}
+
+// Replay a write-ahead log into the list
+template<typename Key>
+long SkipList<Key>::Recover(const char* path) {
+    Wal* attached = wal;
+    wal = nullptr; // replay 중에는 다시 로그를 남기지 않는다
+    long count = Wal::Replay(path, [this](WalOp op, uint64_t key, uint64_t) {
+        if (op == WAL_INSERT) {
+            Insert(key);
+        } else if (op == WAL_DELETE) {
+            Delete(key);
+        }
+    });
+    wal = attached;
+    return count;
+}
+
+// Create or remove the front cache
+template<typename Key>
+void SkipList<Key>::EnableHotCache(size_t slots) {
+    delete hot_cache;
+    hot_cache = slots > 0 ? new HotKeyCache<Key>(slots) : nullptr;
+}
+
+// Create or remove the Bloom filter
+template<typename Key>
+void SkipList<Key>::EnableBloomFilter(int bits_per_key) {
+    delete bloom;
+    bloom = nullptr;
+    bloom_bits_per_key = bits_per_key;
+    if (bits_per_key > 0) {
+        RebuildBloomFilter();
+    }
+}
+
+// Size the filter for twice the current key count and add every key of level 0
+template<typename Key>
+void SkipList<Key>::RebuildBloomFilter() {
+    size_t count = 0;
+    for (Node* node = head->next[0]; node != nullptr; node = node->next[0]) {
+        count++;
+    }
+    delete bloom;
+    bloom = new BlockedBloomFilter<Key>(std::max<size_t>(count * 2, 1024), bloom_bits_per_key);
+    for (Node* node = head->next[0]; node != nullptr; node = node->next[0]) {
+        bloom->Add(node->key);
+    }
+}
+
 template<typename Key>
 void SkipList<Key>::Print() const {
 
@@ -214,4 +471,6 @@ void SkipList<Key>::Print() const {
 
   }
 
-}
\ No newline at end of file
+}
+
+#endif
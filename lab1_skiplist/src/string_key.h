@@ -0,0 +1,134 @@
+#ifndef STRING_KEY_H
+#define STRING_KEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Variable-length byte-string key for SkipList<StringKey> / Bplustree<StringKey>.
+//
+// The key is a small fixed-size handle: an abbreviated key holding the first 8 bytes big-endian
+// (zero padded), plus a pointer / length to the full bytes. Two keys are compared on the abbreviated
+// keys first, which is one integer compare; only keys whose first 8 bytes are equal read the rest.
+// The bytes of inserted keys live in a KeyArena, not in std::string, so a key costs no allocation
+// of its own and the index nodes never own string memory.
+struct StringKey {
+    uint64_t prefix;  // First 8 bytes, big-endian, so that integer order is byte order
+    const char* data; // Full key bytes (not NUL-terminated)
+    uint32_t len;
+
+    StringKey() : prefix(0), data(""), len(0) {}
+
+    // View over bytes owned by the caller. Fine for lookups; keys that are inserted must come from
+    // KeyArena::Make, because the index keeps the pointer.
+    StringKey(const char* bytes, size_t n) : prefix(Abbreviate(bytes, n)), data(bytes), len((uint32_t)n) {}
+
+    static uint64_t Abbreviate(const char* bytes, size_t n) {
+        uint64_t word = 0;
+        memcpy(&word, bytes, std::min<size_t>(n, 8));
+        return __builtin_bswap64(word);
+    }
+
+    // Compare function: <0, 0, >0 in byte-wise (memcmp) order, shorter first on a common prefix.
+    static int Compare(const StringKey& a, const StringKey& b) {
+        if (a.prefix != b.prefix) {
+            return a.prefix < b.prefix ? -1 : 1;
+        }
+        // 앞 8바이트가 같을 때만 나머지 바이트를 비교한다 (8바이트보다 짧은 쪽은 길이로 정해진다)
+        uint32_t n = std::min(a.len, b.len);
+        if (n > 8) {
+            int c = memcmp(a.data + 8, b.data + 8, n - 8);
+            if (c != 0) return c;
+        }
+        return a.len < b.len ? -1 : (a.len > b.len ? 1 : 0);
+    }
+
+    std::string ToString() const { return std::string(data, len); }
+};
+
+inline bool operator==(const StringKey& a, const StringKey& b) {
+    return a.prefix == b.prefix && a.len == b.len && (a.len <= 8 || memcmp(a.data + 8, b.data + 8, a.len - 8) == 0);
+}
+inline bool operator!=(const StringKey& a, const StringKey& b) { return !(a == b); }
+inline bool operator<(const StringKey& a, const StringKey& b) { return StringKey::Compare(a, b) < 0; }
+inline bool operator>(const StringKey& a, const StringKey& b) { return StringKey::Compare(a, b) > 0; }
+inline bool operator<=(const StringKey& a, const StringKey& b) { return StringKey::Compare(a, b) <= 0; }
+inline bool operator>=(const StringKey& a, const StringKey& b) { return StringKey::Compare(a, b) >= 0; }
+
+inline std::ostream& operator<<(std::ostream& os, const StringKey& key) { return os.write(key.data, key.len); }
+
+// SeparatorKey function: Shortest separator for a B+ tree split (prefix / suffix truncation).
+// Returns the shortest prefix of 'right' that is still greater than 'left', so the internal nodes hold
+// only as many bytes as are needed to tell the two leaves apart. It shares the bytes of 'right'.
+inline StringKey SeparatorKey(const StringKey& left, const StringKey& right) {
+    if (!(left < right)) {
+        return right; // 중복 key로 나뉜 경우
+    }
+    uint32_t n = std::min(left.len, right.len);
+    uint32_t i = 0;
+    while (i < n && left.data[i] == right.data[i]) i++;
+    return StringKey(right.data, i + 1); // 처음 달라지는 바이트까지 (left가 right의 prefix면 그 다음 바이트까지)
+}
+
+namespace std {
+template<>
+struct hash<StringKey> {
+    size_t operator()(const StringKey& key) const {
+        // FNV-1a over the bytes
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (uint32_t i = 0; i < key.len; i++) {
+            h = (h ^ (unsigned char)key.data[i]) * 0x100000001b3ull;
+        }
+        return (size_t)h;
+    }
+};
+}
+
+// Bump allocator for key bytes. Bytes are only released when the arena is destroyed, so the arena
+// must outlive every index holding its keys; deleting a key from an index leaves its bytes in place.
+class KeyArena {
+   public:
+    explicit KeyArena(size_t block_size = 1 << 16) : cursor(nullptr), left(0), block_size(block_size), used(0), allocated(0) {}
+    ~KeyArena() {
+        for (char* block : blocks) delete[] block;
+    }
+    KeyArena(const KeyArena&) = delete;
+    KeyArena& operator=(const KeyArena&) = delete;
+
+    // Make function: Copies the bytes into the arena and returns a key over the copy.
+    StringKey Make(const char* bytes, size_t n) {
+        if (n > left) {
+            // 블록이 모자라면 새 블록 (블록보다 긴 key는 그 key만의 블록)
+            size_t size = std::max(n, block_size);
+            blocks.push_back(new char[size]);
+            allocated += size;
+            cursor = blocks.back();
+            left = size;
+        }
+        memcpy(cursor, bytes, n);
+        StringKey key(cursor, n);
+        cursor += n;
+        left -= n;
+        used += n;
+        return key;
+    }
+    StringKey Make(const std::string& s) { return Make(s.data(), s.size()); }
+
+    size_t BytesUsed() const { return used; }
+    size_t MemoryBytes() const { return allocated; }
+
+   private:
+    std::vector<char*> blocks;
+    char* cursor;
+    size_t left;
+    size_t block_size;
+    size_t used;      // Key bytes handed out
+    size_t allocated; // Block bytes
+};
+
+#endif
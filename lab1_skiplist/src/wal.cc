@@ -0,0 +1,250 @@
+#include "wal.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <chrono>
+
+// crc32 (IEEE, reflected 0xEDB88320) lookup table, built on first use
+static uint32_t crc_table[256];
+
+static void init_crc_table() {
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t c = i;
+		for (int k = 0; k < 8; k++) {
+			c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		}
+		crc_table[i] = c;
+	}
+}
+
+static uint32_t crc32(const unsigned char* data, size_t len) {
+	static std::once_flag once;
+	std::call_once(once, init_crc_table);
+	uint32_t c = 0xFFFFFFFFu;
+	for (size_t i = 0; i < len; i++) {
+		c = crc_table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+	}
+	return c ^ 0xFFFFFFFFu;
+}
+
+static size_t encode_varint(unsigned char* buf, uint64_t v) {
+	size_t n = 0;
+	while (v >= 0x80) {
+		buf[n++] = (unsigned char)(v | 0x80);
+		v >>= 7;
+	}
+	buf[n++] = (unsigned char)v;
+	return n;
+}
+
+// Decodes a varint from [buf, buf+avail). Returns bytes read, 0 if it is truncated.
+static size_t decode_varint(const unsigned char* buf, size_t avail, uint64_t* v) {
+	uint64_t x = 0;
+	int shift = 0;
+	for (size_t n = 0; n < avail && shift < 64; n++) {
+		unsigned char b = buf[n];
+		x |= (uint64_t)(b & 0x7F) << shift;
+		shift += 7;
+		if (!(b & 0x80)) {
+			*v = x;
+			return n + 1;
+		}
+	}
+	return 0;
+}
+
+// Encodes 'op' and its keys into buf (op byte + varint keys). Returns bytes written.
+static size_t encode_body(unsigned char* buf, WalOp op, uint64_t key, uint64_t hi) {
+	size_t n = 0;
+	buf[n++] = op;
+	n += encode_varint(buf + n, key);
+	if (op == WAL_DELETE_RANGE) {
+		n += encode_varint(buf + n, hi);
+	}
+	return n;
+}
+
+// Walks the encoded records in [data, data+size).
+// Calls 'apply' for every valid record and stores the length of the valid prefix in 'valid'.
+static long scan_log(const unsigned char* data, size_t size,
+		const std::function<void(WalOp, uint64_t, uint64_t)>* apply, size_t* valid) {
+	size_t off = 0;
+	long count = 0;
+	while (off + 4 + 2 <= size) {
+		const unsigned char* body = data + off + 4;
+		size_t avail = size - off - 4;
+		WalOp op = (WalOp)body[0];
+		if (op != WAL_INSERT && op != WAL_DELETE && op != WAL_DELETE_RANGE) break;
+
+		uint64_t key = 0, hi = 0;
+		size_t n = 1;
+		size_t len = decode_varint(body + n, avail - n, &key);
+		if (len == 0) break;
+		n += len;
+		if (op == WAL_DELETE_RANGE) {
+			len = decode_varint(body + n, avail - n, &hi);
+			if (len == 0) break;
+			n += len;
+		}
+
+		uint32_t stored;
+		memcpy(&stored, data + off, 4);
+		if (stored != crc32(body, n)) break;
+
+		if (apply) (*apply)(op, key, hi);
+		off += 4 + n;
+		count++;
+	}
+	*valid = off;
+	return count;
+}
+
+Wal::Wal(const char* path, long commit_interval_us)
+	: commit_interval_us(commit_interval_us), next_lsn(1), durable_lsn(0), sync_count(0), error(0), stop(false) {
+	fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		// 열지 못한 로그: flusher 없이, 모든 기다림이 이 에러를 돌려준다
+		error = errno;
+		return;
+	}
+
+	// 이전 실행에서 잘린(torn) 레코드가 남아 있으면 잘라내고 그 뒤에 이어서 쓴다
+	struct stat st;
+	fstat(fd, &st);
+	size_t valid = 0;
+	if (st.st_size > 0) {
+		void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED) {
+			scan_log((const unsigned char*)map, st.st_size, nullptr, &valid);
+			munmap(map, st.st_size);
+		}
+		if ((off_t)valid != st.st_size && ftruncate(fd, valid) != 0) {
+			perror("wal: ftruncate");
+		}
+	}
+	lseek(fd, valid, SEEK_SET);
+
+	flusher = std::thread(&Wal::FlushLoop, this);
+}
+
+Wal::~Wal() {
+	{
+		std::lock_guard<std::mutex> lock(mu);
+		stop = true;
+	}
+	work_cv.notify_one();
+	if (flusher.joinable()) flusher.join();
+	if (fd >= 0) close(fd);
+}
+
+uint64_t Wal::Append(WalOp op, uint64_t key, uint64_t hi) {
+	unsigned char rec[4 + 1 + 10 + 10];
+	size_t n = encode_body(rec + 4, op, key, hi);
+	uint32_t crc = crc32(rec + 4, n);
+	memcpy(rec, &crc, 4);
+
+	std::lock_guard<std::mutex> lock(mu);
+	uint64_t lsn = next_lsn++;
+	if (error == 0) {
+		pending.insert(pending.end(), rec, rec + 4 + n);
+		work_cv.notify_one();
+	}
+	return lsn;
+}
+
+int Wal::WaitDurable(uint64_t lsn) {
+	std::unique_lock<std::mutex> lock(mu);
+	durable_cv.wait(lock, [&] { return durable_lsn >= lsn || error != 0; });
+	return error; // 실패가 한 번이라도 있었으면 이미 durable한 LSN이어도 그 오류를 돌려준다
+}
+
+int Wal::Sync() {
+	uint64_t lsn;
+	{
+		std::lock_guard<std::mutex> lock(mu);
+		lsn = next_lsn - 1;
+	}
+	return WaitDurable(lsn);
+}
+
+int Wal::Error() {
+	std::lock_guard<std::mutex> lock(mu);
+	return error;
+}
+
+uint64_t Wal::SyncCount() {
+	std::lock_guard<std::mutex> lock(mu);
+	return sync_count;
+}
+
+void Wal::FlushLoop() {
+	std::vector<char> batch;
+	std::unique_lock<std::mutex> lock(mu);
+	while (true) {
+		work_cv.wait(lock, [&] { return stop || !pending.empty(); });
+		if (pending.empty()) break; // stop requested and nothing left
+
+		// 1. durability window 동안 다른 writer들이 같은 그룹에 합류하도록 기다린다
+		if (commit_interval_us > 0 && !stop) {
+			work_cv.wait_for(lock, std::chrono::microseconds(commit_interval_us), [&] { return stop; });
+		}
+
+		// 2. 지금까지 모인 레코드를 한 번의 write + fdatasync로 내린다
+		batch.swap(pending);
+		uint64_t batch_lsn = next_lsn - 1;
+		lock.unlock();
+
+		int failed = 0;
+		size_t off = 0;
+		while (off < batch.size()) {
+			ssize_t w = write(fd, batch.data() + off, batch.size() - off);
+			if (w < 0) {
+				if (errno == EINTR) continue;
+				failed = errno;
+				break;
+			}
+			off += w;
+		}
+		if (failed == 0 && fdatasync(fd) != 0) {
+			failed = errno;
+		}
+		batch.clear();
+
+		// 3. 기다리던 writer들을 깨운다. 실패했다면 durable_lsn은 그대로 두고 에러를 남긴다
+		//    (실패한 fdatasync 뒤에는 무엇이 디스크에 있는지 알 수 없으므로 더 쓰지 않는다)
+		lock.lock();
+		if (failed != 0) {
+			error = failed;
+			pending.clear();
+			durable_cv.notify_all();
+			break;
+		}
+		durable_lsn = batch_lsn;
+		sync_count++;
+		durable_cv.notify_all();
+	}
+}
+
+long Wal::Replay(const char* path, const std::function<void(WalOp, uint64_t, uint64_t)>& apply) {
+	int rfd = open(path, O_RDONLY);
+	if (rfd < 0) return 0; // no log yet
+
+	struct stat st;
+	fstat(rfd, &st);
+	long count = 0;
+	if (st.st_size > 0) {
+		void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, rfd, 0);
+		if (map != MAP_FAILED) {
+			size_t valid;
+			count = scan_log((const unsigned char*)map, st.st_size, &apply, &valid);
+			munmap(map, st.st_size);
+		}
+	}
+	close(rfd);
+	return count;
+}
@@ -1,3 +1,6 @@
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
 #include <stdlib.h>
 #include <cstdint>
 #include <algorithm>
@@ -11,9 +14,21 @@
 #include <functional>
 #include <mutex>
 #include <vector>
+#include <thread>
 
 #include <atomic>
-
+#include <type_traits>
+
+#include "wal.h"
+#include "leaf_kernels.h"
+#include "frozen_bplustree.h"
+#include "learned_index.h"
+#include "hot_cache.h"
+#include "bloom_filter.h"
+
+// Shared with the other labs' headers, so that several indexes can be used in one program
+#ifndef INDEX_KEY_TYPES
+#define INDEX_KEY_TYPES
 // Define Clock and Key types
 typedef std::chrono::high_resolution_clock Clock;
 typedef uint64_t Key;
@@ -28,6 +43,14 @@ int compare_(const Key& a, const Key& b) {
         return 0;
     }
 }
+#endif
+
+// Separator pushed up when a leaf splits: any key in (left, right] routes correctly.
+// Fixed-size keys use 'right' itself; string_key.h overloads it with the shortest separating prefix.
+template<typename Key>
+Key SeparatorKey(const Key& left, const Key& right) {
+    return right;
+}
 
 // B+ Tree class template definition
 template<typename Key>
@@ -41,12 +64,22 @@ class Bplustree {
    public:
     // Constructor: Initializes a B+ Tree with the specified degree (maximum number of children per internal node)
     Bplustree(int degree = 4);
+    ~Bplustree(); // Frees every node and the optional learned layer / cache / filter
+    Bplustree(const Bplustree&) = delete;
+    Bplustree& operator=(const Bplustree&) = delete;
 
     // Insert function:
     // Inserts a key into the B+ Tree.
     // TODO: Implement insertion, handling leaf node insertion and splitting if necessary.
     void Insert(const Key& key);
 
+    // InsertBatch function:
+    // Inserts 'n' keys given in ascending order. The keys that fall into one leaf are merged into it
+    // in one pass after a single descent; a full leaf takes the next key through Insert so that it splits.
+    // With 'skip_existing', keys already in the tree (or repeated in the batch) are left out.
+    // Returns the number of keys inserted.
+    size_t InsertBatch(const Key* keys, size_t n, bool skip_existing = false);
+
     // Contains function:
     // Returns true if the key exists in the tree; otherwise, returns false.
     // TODO: Implement key lookup starting from the root and traversing to the appropriate leaf.
@@ -57,16 +90,124 @@ class Bplustree {
     // TODO: Traverse leaf nodes using the next pointer and collect keys.
     std::vector<Key> Scan(const Key& key, const int scan_num);
 
+    // Key-value functions (Bplustree<KVEntry<K, V>>, kv_entry.h):
+    // Entries compare by key only, so the value is stored inline in the leaf next to its key.
+    // Upsert overwrites the stored entry with an equal key in place after a single descent, or inserts
+    // the entry (only a full leaf needs a second descent to split). Returns true if the key was new.
+    bool Upsert(const Key& key);
+    // Find returns the stored element equal to 'key' (nullptr if absent); valid until the next update.
+    const Key* Find(const Key& key) const;
+    // ScanVisit calls visit(const Key&) on up to 'scan_num' stored elements from 'key' on, in place
+    // (leaves with a pending append buffer are visited from a merged scratch copy).
+    template<typename Visitor>
+    void ScanVisit(const Key& key, const int scan_num, Visitor visit) const;
+
+    // ParallelScan function:
+    // Visits every key in [lo, hi] with 'threads' workers and returns the merged visitor.
+    // The range is split at child boundaries of the internal nodes; each subrange is walked through
+    // the leaf chain by one worker with its own copy of 'visitor', and the copies are merged in key order.
+    // Visitor must provide 'void operator()(const Key&)' and 'void Merge(const Visitor&)'.
+    template<typename Visitor>
+    Visitor ParallelScan(const Key& lo, const Key& hi, const Visitor& visitor, int threads) const;
+
+    // Range aggregate functions:
+    // Computed directly on the leaf key arrays while walking the next chain; no key is copied out
+    // (except for leaves with a pending append buffer, which are merged into a scratch copy first).
+    // CountRange and MinMaxRange only read the sizes / ends of leaves that lie fully inside the range,
+    // SumRange and CountMasked run SIMD kernels (leaf_kernels.h) over the keys.
+    size_t CountRange(const Key& lo, const Key& hi) const;
+    Key SumRange(const Key& lo, const Key& hi) const;
+    // Stores the smallest and largest key of [lo, hi] in 'min_key' / 'max_key'. Returns false if there is none.
+    bool MinMaxRange(const Key& lo, const Key& hi, Key& min_key, Key& max_key) const;
+    // Number of keys in [lo, hi] with (key & mask) == value
+    size_t CountMasked(const Key& lo, const Key& hi, uint64_t mask, uint64_t value) const;
+    // Number of keys in [lo, hi] for which pred(key) is true
+    template<typename Pred>
+    size_t CountIf(const Key& lo, const Key& hi, Pred pred) const;
+
     // Delete function:
-    // Removes the specified key from the tree.
-    // TODO: Implement deletion, handling key removal, merging, or rebalancing nodes if required.
+    // Removes the specified key from the tree. Insert keeps duplicates, and Delete removes every copy of
+    // the key at once (a DeleteRange of one key). Returns false if the key was not in the tree.
     bool Delete(const Key& key);
 
+    // DeleteRange function:
+    // Removes every key in [lo, hi] and returns the number of keys removed.
+    // Leaves lying completely inside the range are unlinked and freed as a whole,
+    // only the two edge leaves are trimmed, and the internal levels are repaired on the way back up.
+    size_t DeleteRange(const Key& lo, const Key& hi);
+
+    // Freeze function:
+    // Exports the current keys into an immutable, pointer-free FrozenBplustree for read-only replicas.
+    FrozenBplustree<Key> Freeze() const;
+
+    // EnableLearnedIndex function (arithmetic keys only):
+    // Fits an error-bounded piecewise linear model (learned_index.h) over the leaf boundaries and lets
+    // FindLeaf predict the leaf directly instead of descending the internal nodes. Leaf splits in Insert
+    // update the model incrementally. Deletes that free, merge or redistribute leaves mark it stale;
+    // FindLeaf then falls back to the normal descent until RetrainLearnedIndex() is called.
+    void EnableLearnedIndex(size_t epsilon = 16);
+    void RetrainLearnedIndex();
+
+    // Memory used by the learned layer and by the internal nodes it replaces, in bytes
+    size_t LearnedIndexBytes() const;
+    size_t InternalNodeBytes() const;
+
+    // EnableLeafBuffer function:
+    // Gives every leaf an unsorted append buffer of up to 'capacity' keys (0 turns it off).
+    // Insert then only appends to the buffer; the buffer is sorted and merged into the leaf keys
+    // when it fills up or the leaf has to split, so the O(leaf size) shift is paid once per 'capacity' inserts.
+    // Contains also checks the buffer, and the range reads merge it into the sorted keys of that leaf on the fly.
+    void EnableLeafBuffer(size_t capacity);
+
+    // EnableHotCache function:
+    // Puts a small direct-mapped HotKeyCache (hot_cache.h) with 'slots' entries in front of Contains,
+    // so skewed point lookups skip the descent (0 removes it). Insert, Delete and DeleteRange keep it
+    // consistent; HotCache() exposes its hit/miss counters.
+    void EnableHotCache(size_t slots = 4096);
+    HotKeyCache<Key>* HotCache() const { return hot_cache; }
+
+    // EnableBloomFilter function:
+    // Puts a cache-line blocked Bloom filter (bloom_filter.h) with 'bits_per_key' bits per key in front of
+    // Contains and Delete, so keys that were never inserted return without descending the tree (0 removes it).
+    // When more keys were added than the filter was sized for, it is rebuilt from the leaves twice as large,
+    // which also drops the bits of deleted keys.
+    void EnableBloomFilter(int bits_per_key = 10);
+    const BlockedBloomFilter<Key>* BloomFilter() const { return bloom; }
+
+    // Memory footprint of the tree, by category. Every node is one allocation for the node struct and
+    // one per key/child array; 'allocator_bytes' is what malloc adds to them (chunk header and rounding).
+    struct MemoryStats {
+        size_t leaves;          // Leaf nodes
+        size_t internal_nodes;  // Internal nodes
+        int height;             // Levels, the leaf level included
+        size_t keys;            // Keys in the leaves (buffers included)
+        double leaf_fill;       // keys / (leaves * (degree - 1))
+        double internal_fill;   // children / (internal_nodes * degree)
+        size_t key_bytes;       // Keys in use, leaves and internal nodes
+        size_t pointer_bytes;   // Child pointers in use
+        size_t slack_bytes;     // Reserved but unused capacity of the key/child arrays
+        size_t header_bytes;    // Node structs (vtable, vector headers, next pointer)
+        size_t allocator_bytes; // malloc overhead of the node and array allocations
+        size_t aux_bytes;       // Learned layer, hot cache and Bloom filter
+        size_t total_bytes;
+    };
+    MemoryStats MemoryUsage() const;
+
     // Print function:
     // Traverses and prints the internal structure of the B+ Tree.
     // This function is helpful for debugging and verifying that the tree is constructed correctly.
     void Print() const;
 
+    // AttachWal function:
+    // Logs every following Insert/Delete/DeleteRange to 'wal'.
+    // The change is durable once the caller's wal->Sync() returns (group commit).
+    void AttachWal(Wal* wal);
+
+    // Recover function:
+    // Replays the log at 'path' into the tree and returns the number of records applied.
+    // Call this at startup, before AttachWal, so that the replay is not logged again.
+    long Recover(const char* path);
+
    private:
     // Base Node structure. All nodes (internal and leaf) derive from this.
     struct Node {
@@ -88,95 +229,314 @@ class Bplustree {
     // Leaf node structure for the B+ Tree.
     // Stores actual keys and a pointer to the next leaf for efficient range queries.
     struct LeafNode : public Node {
-        std::vector<Key> keys; // Keys stored in the leaf node
-        LeafNode* next;        // Pointer to the next leaf node for range scanning
+        std::vector<Key> keys;   // Keys stored in the leaf node
+        std::vector<Key> buffer; // Unsorted recent inserts, merged into 'keys' when full (see EnableLeafBuffer)
+        LeafNode* next;          // Pointer to the next leaf node for range scanning
         LeafNode() : next(nullptr) { this->is_leaf = true; }
     };
 
-    // Helper function to insert a key into an internal node.
+    // Helper function to insert a key into the subtree rooted at 'current'.
     // 'new_child' and 'new_key' are output parameters if the node splits.
-    // TODO: Implement insertion into an internal node and handle splitting of nodes.
+    // TODO: Implement insertion into a leaf/internal node and handle splitting of nodes.
     void InsertInternal(Node* current, const Key& key, Node*& new_child, Key& new_key);
 
-    // Helper function to delete a key from the tree recursively.
-    // TODO: Implement deletion from internal nodes with proper merging or rebalancing.
-    bool DeleteInternal(Node* current, const Key& key);
+    // Helper function to delete the keys in [lo, hi] from the subtree rooted at 'current'.
+    // 'prev' is the last surviving leaf seen so far in key order; freed leaves are unlinked from it.
+    // Returns true if 'current' became empty and was freed.
+    bool DeleteInternal(Node* current, const Key& lo, const Key& hi, LeafNode*& prev, size_t& removed);
+
+    // Helper function shared by Delete and DeleteRange. Returns the number of keys removed.
+    size_t EraseRange(const Key& lo, const Key& hi);
+
+    // Helper function to free a whole subtree, unlinking its leaves from 'prev'. Returns the number of keys freed.
+    size_t FreeSubtree(Node* node, LeafNode*& prev);
+
+    // Helper function to fix underflow of children i and i+1 of 'parent' by merging or redistributing.
+    void Rebalance(InternalNode* parent, size_t i, LeafNode*& prev);
+
+    // Helper function to sort the append buffer of 'leaf' into its keys.
+    void MergeBuffer(LeafNode* leaf);
+
+    // Helper function that returns the sorted keys of 'leaf' in [first, first + n).
+    // Without a buffer this is the key array itself; otherwise keys and buffer are merged into 'scratch'.
+    const Key* SortedKeys(const LeafNode* leaf, std::vector<Key>& scratch, size_t& n) const;
+
+    // Helper function to re-size the Bloom filter to the current key count and refill it from the leaves.
+    void RebuildBloomFilter();
+
+    // Helper function to log an update to the attached WAL. The log stores integer keys, so trees over
+    // other key types (string_key.h) never log.
+    void LogUpdate(WalOp op, const Key& lo, const Key& hi = Key{}) const {
+        if constexpr (std::is_integral<Key>::value) {
+            if (wal) wal->Append(op, lo, hi);
+        }
+    }
 
     // Helper function to find the leaf node where the key should reside.
     // TODO: Implement traversal from the root to the appropriate leaf node.
     LeafNode* FindLeaf(const Key& key) const;
 
+    // Helper function to find the leftmost leaf that may hold 'key'. FindLeaf descends right of a separator
+    // equal to 'key', which skips copies of a duplicate key left in the left sibling; range walks start here.
+    LeafNode* FindFirstLeaf(const Key& key) const;
+
+    // Helper function that returns true if at least one key lies in [lo, hi].
+    bool ContainsRange(const Key& lo, const Key& hi) const;
+
+    // Helper function to split [lo, hi] at child boundaries into at least 'parts' subranges if the tree allows.
+    // Returns the split keys in ascending order; subrange i is [split[i-1], split[i]).
+    std::vector<Key> SplitRange(const Key& lo, const Key& hi, size_t parts) const;
+
+    // Helper function that calls 'visit(keys, n)' for the run of keys in [lo, hi] of every leaf in order,
+    // prefetching the next leaf and its key array while the current one is processed.
+    template<typename RunVisitor>
+    void ForEachRun(const Key& lo, const Key& hi, RunVisitor visit) const;
+
     // Helper function to recursively print the tree structure.
     void PrintRecursive(const Node* node, int level) const;
 
+    // Bytes glibc malloc adds to a request of 'bytes' (8-byte header, 16-byte granularity, 32-byte chunks at least)
+    static size_t MallocOverhead(size_t bytes) {
+        if (bytes == 0) return 0;
+        size_t chunk = std::max<size_t>(32, (bytes + 8 + 15) & ~(size_t)15);
+        return chunk - bytes;
+    }
+
     Node* root;   // Root node of the B+ Tree
     int degree;   // Maximum number of children per internal node
+    Wal* wal;     // Optional write-ahead log (nullptr if not attached)
+
+    PiecewiseLinearIndex<Key, LeafNode*>* learned; // Optional learned routing layer (nullptr if disabled)
+    bool learned_stale;                            // Leaf boundaries changed since the last fit
+
+    size_t leaf_buffer; // Capacity of the per-leaf append buffer (0 if disabled)
+
+    HotKeyCache<Key>* hot_cache; // Optional front cache for point lookups (nullptr if disabled)
+
+    BlockedBloomFilter<Key>* bloom; // Optional filter for negative lookups (nullptr if disabled)
+    int bloom_bits_per_key;
 };
 
 // Constructor implementation
 // Initializes the tree by creating an empty leaf node as the root.
 template<typename Key>
-Bplustree<Key>::Bplustree(int degree) : degree(degree) {
+Bplustree<Key>::Bplustree(int degree) : degree(degree), wal(nullptr), learned(nullptr), learned_stale(false), leaf_buffer(0), hot_cache(nullptr), bloom(nullptr), bloom_bits_per_key(0) {
     root = new LeafNode();
     // To be implemented by students
 }
 
+// Destructor for Bplustree
+template<typename Key>
+Bplustree<Key>::~Bplustree() {
+    // root부터 모든 노드를 해제 (리프 체인을 끊을 앞 리프는 없다)
+    LeafNode* prev = nullptr;
+    FreeSubtree(root, prev);
+    if constexpr (std::is_arithmetic<Key>::value) {
+        delete learned; // 숫자 key에서만 만들어진다
+    }
+    delete hot_cache;
+    delete bloom;
+}
+
 // Insert function: Inserts a key into the B+ Tree.
 template<typename Key>
 void Bplustree<Key>::Insert(const Key& key) {
     // TODO: Implement insertion logic here.
-    LeafNode* leaf = FindLeaf(key);
+    // 0. 트리를 바꾸기 전에 먼저 로그에 남긴다
+    LogUpdate(WAL_INSERT, key);
 
-    // 1. Leaf에 key 삽입 (정렬된 위치)
-    auto it = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
-    leaf->keys.insert(it, key);
+    // 1. root부터 내려가며 삽입, split이 생기면 new_child / new_key로 올라온다
+    Node* new_child = nullptr;
+    Key new_key{};
+    InsertInternal(root, key, new_child, new_key);
 
-    // 2. Overflow 체크
-    if (leaf->keys.size() < degree) {
-        // Overflow 안 났으면 끝
-        return;
+    // 2. root까지 split 됐다면 새로운 root 생성
+    if (new_child) {
+        InternalNode* new_root = new InternalNode();
+        new_root->keys.push_back(new_key);
+        new_root->children.push_back(root);
+        new_root->children.push_back(new_child);
+        root = new_root;
+    }
+    if (hot_cache) hot_cache->Update(key, true);
+    if (bloom) {
+        bloom->Add(key);
+        if (bloom->Full()) RebuildBloomFilter();
     }
+    // To be implemented by students
+}
 
-    // 3. Overflow 났으면 Leaf Split
-    LeafNode* new_leaf = new LeafNode();
-    int mid = (degree + 1) / 2;
 
-    // keys를 반으로 나눔
-    new_leaf->keys.assign(leaf->keys.begin() + mid, leaf->keys.end());
-    leaf->keys.resize(mid);
+// InsertBatch function: Merges a sorted batch into the tree leaf by leaf.
+template<typename Key>
+size_t Bplustree<Key>::InsertBatch(const Key* keys, size_t n, bool skip_existing) {
+    size_t inserted = 0;
+    std::vector<Key> run;
+    size_t i = 0;
+    while (i < n) {
+        // 1. 첫 key가 들어갈 리프를 찾으면서, 그 리프가 맡는 범위의 상한(fence)도 기억한다
+        Node* current = root;
+        bool bounded = false;
+        Key fence{};
+        while (!current->is_leaf) {
+            InternalNode* internal = current->as_internal();
+            auto itr = std::upper_bound(internal->keys.begin(), internal->keys.end(), keys[i]);
+            if (itr != internal->keys.end()) {
+                fence = *itr;
+                bounded = true;
+            }
+            current = internal->children[itr - internal->keys.begin()];
+        }
+        LeafNode* leaf = current->as_leaf();
+        MergeBuffer(leaf);
+
+        // 2. fence 아래의 key들을 split 없이 들어갈 만큼만 모은다
+        size_t room = leaf->keys.size() + 1 < (size_t)degree ? degree - 1 - leaf->keys.size() : 0;
+        run.clear();
+        size_t j = i;
+        for (; j < n && run.size() < room && (!bounded || keys[j] < fence); j++) {
+            if (skip_existing && ((!run.empty() && run.back() == keys[j]) ||
+                                  std::binary_search(leaf->keys.begin(), leaf->keys.end(), keys[j]))) {
+                continue;
+            }
+            run.push_back(keys[j]);
+        }
 
-    // next 포인터 연결
-    new_leaf->next = leaf->next;
-    leaf->next = new_leaf;
+        // 3. 리프가 이미 가득 찼으면 한 key만 Insert로 넣어 split 시키고 다시 내려간다
+        if (j == i) {
+            if (!skip_existing || !std::binary_search(leaf->keys.begin(), leaf->keys.end(), keys[i])) {
+                Insert(keys[i]);
+                inserted++;
+            }
+            i++;
+            continue;
+        }
+
+        // 4. 로그에 먼저 남기고, 모은 key들을 리프에 한 번에 병합
+        for (const Key& key : run) LogUpdate(WAL_INSERT, key);
+        size_t old_size = leaf->keys.size();
+        leaf->keys.insert(leaf->keys.end(), run.begin(), run.end());
+        std::inplace_merge(leaf->keys.begin(), leaf->keys.begin() + old_size, leaf->keys.end());
+        for (const Key& key : run) {
+            if (hot_cache) hot_cache->Update(key, true);
+            if (bloom) {
+                bloom->Add(key);
+                if (bloom->Full()) RebuildBloomFilter();
+            }
+        }
+        inserted += run.size();
+        i = j;
+    }
+    return inserted;
+}
 
-    // 4. 부모에 새 key 등록
-    Node* new_child = new_leaf;
-    Key new_key = new_leaf->keys[0]; // 새 리프의 첫 번째 키를 부모로 올림
+// Upsert function: Overwrites an equal key in its leaf or inserts the key.
+template<typename Key>
+bool Bplustree<Key>::Upsert(const Key& key) {
+    LeafNode* leaf = FindLeaf(key);
 
-    // 만약 root였다면 새로운 root 생성
-    if (leaf == root) {
-        InternalNode* new_root = new InternalNode();
-        new_root->keys.push_back(new_key);
-        new_root->children.push_back(leaf);
-        new_root->children.push_back(new_child);
-        root = new_root;
-        return;
+    // 1. 이미 있으면 그 자리에서 덮어쓴다 (정렬된 keys와 아직 병합되지 않은 buffer 모두 확인)
+    auto itr = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
+    if (itr != leaf->keys.end() && *itr == key) {
+        *itr = key;
+        return false;
+    }
+    auto buffered = std::find(leaf->buffer.begin(), leaf->buffer.end(), key);
+    if (buffered != leaf->buffer.end()) {
+        *buffered = key;
+        return false;
     }
 
-    // leaf의 부모 찾아서 InsertInternal 호출
-    InsertInternal(root, new_key, new_child, new_key);
-    // To be implemented by students
+    // 2. 새 key만 로그에 남긴다. replay는 Insert로 하므로 덮어쓰기까지 남기면 복구 후 중복 key가 생긴다
+    LogUpdate(WAL_INSERT, key);
+
+    // 3. 새 key: split이 필요 없으면 찾은 리프에 바로 넣고, 아니면 root부터 InsertInternal로 split까지 처리
+    if (leaf->keys.size() + leaf->buffer.size() + 1 < (size_t)degree) {
+        if (leaf_buffer > 0) {
+            leaf->buffer.push_back(key);
+            if (leaf->buffer.size() >= leaf_buffer) {
+                MergeBuffer(leaf);
+            }
+        } else {
+            leaf->keys.insert(itr, key);
+        }
+    } else {
+        Node* new_child = nullptr;
+        Key new_key{};
+        InsertInternal(root, key, new_child, new_key);
+        if (new_child) {
+            InternalNode* new_root = new InternalNode();
+            new_root->keys.push_back(new_key);
+            new_root->children.push_back(root);
+            new_root->children.push_back(new_child);
+            root = new_root;
+        }
+    }
+    if (hot_cache) hot_cache->Update(key, true);
+    if (bloom) {
+        bloom->Add(key);
+        if (bloom->Full()) RebuildBloomFilter();
+    }
+    return true;
 }
 
+// Find function: Returns the stored element equal to 'key', or nullptr.
+template<typename Key>
+const Key* Bplustree<Key>::Find(const Key& key) const {
+    if (bloom && !bloom->MayContain(key)) {
+        return nullptr;
+    }
+    LeafNode* leaf = FindLeaf(key);
+    auto itr = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
+    if (itr != leaf->keys.end() && *itr == key) {
+        return &*itr;
+    }
+    auto buffered = std::find(leaf->buffer.begin(), leaf->buffer.end(), key);
+    return buffered != leaf->buffer.end() ? &*buffered : nullptr;
+}
+
+// ScanVisit function: Range query that hands the stored elements to 'visit' instead of copying them out.
+template<typename Key>
+template<typename Visitor>
+void Bplustree<Key>::ScanVisit(const Key& key, const int scan_num, Visitor visit) const {
+    std::vector<Key> scratch;
+    LeafNode* leaf = FindLeaf(key);
+    size_t n;
+    const Key* keys = SortedKeys(leaf, scratch, n);
+    const Key* itr = std::lower_bound(keys, keys + n, key);
+
+    int visited = 0;
+    while (leaf && visited < scan_num) {
+        for (; itr != keys + n && visited < scan_num; ++itr, ++visited) {
+            visit(*itr);
+        }
+        leaf = leaf->next;
+        if (leaf) {
+            keys = SortedKeys(leaf, scratch, n);
+            itr = keys;
+        }
+    }
+}
 
 // Contains function: Checks if a key exists in the B+ Tree.
 template<typename Key>
 bool Bplustree<Key>::Contains(const Key& key) const {
     // TODO: Implement lookup logic here.
+    bool found;
+    if (hot_cache && hot_cache->Lookup(key, found)) {
+        return found; // 자주 찾는 key는 내려가지 않고 바로 답한다
+    }
+    if (bloom && !bloom->MayContain(key)) {
+        return false; // 확실히 없는 key는 트리를 내려가지 않는다
+    }
     LeafNode* leaf = FindLeaf(key);
 
     auto itr = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
-    return (itr != leaf->keys.end() && *itr == key);
+    // 아직 병합되지 않은 최근 삽입들도 확인
+    found = (itr != leaf->keys.end() && *itr == key) ||
+            std::find(leaf->buffer.begin(), leaf->buffer.end(), key) != leaf->buffer.end();
+    if (hot_cache) hot_cache->Admit(key, found);
+    return found;
     // To be implemented by students
 }
 
@@ -186,19 +546,23 @@ template<typename Key>
 std::vector<Key> Bplustree<Key>::Scan(const Key& key, const int scan_num) {
     // TODO: Implement range query logic here.
     std::vector<Key> result;
+    std::vector<Key> scratch;
     LeafNode* leaf = FindLeaf(key);
 
     // 1. 리프 안에서 key 이상인 곳부터 시작
-    auto itr = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
+    size_t n;
+    const Key* keys = SortedKeys(leaf, scratch, n);
+    const Key* itr = std::lower_bound(keys, keys + n, key);
 
     // 2. 리프들을 따라가면서 key들을 모은다
     while (leaf && result.size() < static_cast<size_t>(scan_num)) {
-        for (; itr != leaf->keys.end() && result.size() < static_cast<size_t>(scan_num); ++itr) {
+        for (; itr != keys + n && result.size() < static_cast<size_t>(scan_num); ++itr) {
             result.push_back(*itr);
         }
         leaf = leaf->next;
         if (leaf) {
-            itr = leaf->keys.begin();
+            keys = SortedKeys(leaf, scratch, n);
+            itr = keys;
         }
     }
 
@@ -207,116 +571,375 @@ std::vector<Key> Bplustree<Key>::Scan(const Key& key, const int scan_num) {
 }
 
 
-// Delete function: Removes a key from the B+ Tree.
+// ParallelScan function: Scans [lo, hi] with several workers, one subrange at a time.
 template<typename Key>
-bool Bplustree<Key>::Delete(const Key& key) {
-    // TODO: Implement deletion logic here.
-    // 1. 리프 노드를 찾아서 key 삭제
-    LeafNode* leaf = FindLeaf(key);
-    auto itr = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
-
-    // 2. key가 없으면 삭제 실패
-    if (itr == leaf->keys.end() || *itr != key) {
-        return false;
+template<typename Visitor>
+Visitor Bplustree<Key>::ParallelScan(const Key& lo, const Key& hi, const Visitor& visitor, int threads) const {
+    if (hi < lo) {
+        return visitor;
+    }
+    if (threads < 1) {
+        threads = 1;
     }
-    leaf->keys.erase(itr);  // key 삭제
-
-    // 3. 리프 노드 underflow 체크
-    if (leaf->keys.size() < (degree - 1) / 2) {
-        LeafNode* sibling = nullptr;
-        bool is_left_sibling = false;
-
-        InternalNode* parent = nullptr;
-        Node* current = root;
 
-        // 4. 부모 노드로부터 형제를 찾는다
-        while (!current->is_leaf) {
-            parent = current->as_internal();
-            bool found = false;
-            for (size_t i = 0; i < parent->keys.size(); ++i) {
-                if (parent->keys[i] > key) {
-                    current = parent->children[i];
-                    found = true;
-                    break;
+    // 1. 작업 분배가 고르게 되도록 worker 수보다 넉넉히 subrange를 나눈다
+    std::vector<Key> split = SplitRange(lo, hi, threads > 1 ? threads * 4 : 1);
+    size_t parts = split.size() + 1;
+    std::vector<Visitor> partial(parts, visitor);
+
+    // 2. subrange 하나를 리프 체인을 따라 훑는다. 마지막 subrange만 hi를 포함한다
+    auto scan_part = [&](size_t p) {
+        const Key& start = p == 0 ? lo : split[p - 1];
+        Visitor& v = partial[p];
+        std::vector<Key> scratch;
+        LeafNode* leaf = FindFirstLeaf(start);
+        size_t n;
+        const Key* keys = SortedKeys(leaf, scratch, n);
+        const Key* itr = std::lower_bound(keys, keys + n, start);
+        while (leaf) {
+            for (; itr != keys + n; ++itr) {
+                if (p + 1 < parts ? !(*itr < split[p]) : hi < *itr) {
+                    return;
                 }
+                v(*itr);
             }
-            if (!found) {
-                current = parent->children.back();
+            leaf = leaf->next;
+            if (leaf) {
+                keys = SortedKeys(leaf, scratch, n);
+                itr = keys;
             }
         }
+    };
 
-        // 부모에서 leaf 노드를 찾았다면, 형제 정보도 찾을 수 있다.
-        for (size_t i = 0; i < parent->keys.size(); ++i) {
-            if (parent->children[i]->as_leaf() == leaf) {
-                if (i > 0) {
-                    sibling = parent->children[i - 1]->as_leaf();
-                    is_left_sibling = true;
-                } else if (i < parent->keys.size()) {
-                    sibling = parent->children[i + 1]->as_leaf();
-                    is_left_sibling = false;
-                }
-                break;
-            }
+    // 3. worker들은 다음 subrange 번호를 하나씩 가져간다
+    std::atomic<size_t> next_part(0);
+    auto worker = [&]() {
+        for (size_t p = next_part++; p < parts; p = next_part++) {
+            scan_part(p);
         }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads && t < (int)parts; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& w : workers) {
+        w.join();
+    }
 
-        // 5. 형제에서 빌리기
-        if (sibling) {
-            if (sibling->keys.size() > (degree - 1) / 2) {
-                if (is_left_sibling) {
-                    leaf->keys.insert(leaf->keys.begin(), sibling->keys.back());
-                    sibling->keys.pop_back();
-                } else {
-                    leaf->keys.push_back(sibling->keys.front());
-                    sibling->keys.erase(sibling->keys.begin());
-                }
-                parent->keys[is_left_sibling ? parent->keys.size() - 1 : 0] = leaf->keys.front();
-            } else {
-                if (is_left_sibling) {
-                    sibling->keys.insert(sibling->keys.end(), leaf->keys.begin(), leaf->keys.end());
-                    parent->keys.pop_back();
-                    parent->children.erase(parent->children.begin() + parent->keys.size());
-                } else {
-                    leaf->keys.insert(leaf->keys.end(), sibling->keys.begin(), sibling->keys.end());
-                    parent->keys.pop_back();
-                    parent->children.erase(parent->children.begin() + parent->keys.size());
+    // 4. key 순서대로 결과를 합친다
+    Visitor result = partial[0];
+    for (size_t p = 1; p < parts; p++) {
+        result.Merge(partial[p]);
+    }
+    return result;
+}
+
+
+// SplitRange function: Collects separator keys inside (lo, hi] level by level until there are enough subranges.
+template<typename Key>
+std::vector<Key> Bplustree<Key>::SplitRange(const Key& lo, const Key& hi, size_t parts) const {
+    std::vector<Key> split;
+    std::vector<Node*> level{root};
+
+    while (split.size() + 1 < parts) {
+        std::vector<Key> keys;
+        std::vector<Node*> children;
+        for (Node* node : level) {
+            if (node->is_leaf) {
+                return split; // 더 나눌 internal level이 없다
+            }
+            InternalNode* internal = node->as_internal();
+            // 범위와 겹치는 자식들과 그 사이의 분리 키만 본다. lo와 같은 분리 키의 왼쪽 자식에도
+            // lo의 복사본이 있을 수 있으므로 EraseRange처럼 lower_bound로 시작한다
+            size_t first = std::lower_bound(internal->keys.begin(), internal->keys.end(), lo) - internal->keys.begin();
+            size_t last = std::upper_bound(internal->keys.begin(), internal->keys.end(), hi) - internal->keys.begin();
+            for (size_t i = first; i <= last; i++) {
+                if (i > first && lo < internal->keys[i - 1]) {
+                    keys.push_back(internal->keys[i - 1]);
                 }
+                children.push_back(internal->children[i]);
             }
         }
+        // 윗 level의 분리 키들도 여전히 경계이므로 함께 정렬해서 쓴다
+        keys.insert(keys.end(), split.begin(), split.end());
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        split.swap(keys);
+        level.swap(children);
     }
+    return split;
+}
+
 
-    // 6. 부모 노드 갱신 및 루트 갱신
-    if (root->as_internal()->children.size() == 1) {
-        // 루트가 하나의 자식만 가질 경우 자식을 루트로 설정
-        root = root->as_internal()->children[0];
+// ForEachRun function: Walks the leaves overlapping [lo, hi] and hands each run of keys to 'visit'.
+template<typename Key>
+template<typename RunVisitor>
+void Bplustree<Key>::ForEachRun(const Key& lo, const Key& hi, RunVisitor visit) const {
+    if (hi < lo) {
+        return;
     }
+    std::vector<Key> scratch;
+    LeafNode* leaf = FindFirstLeaf(lo);
+    size_t n;
+    const Key* keys = SortedKeys(leaf, scratch, n);
+    const Key* first = std::lower_bound(keys, keys + n, lo);
+
+    while (leaf) {
+        // 다음 리프의 노드와 key 배열을 미리 가져온다
+        LeafNode* next = leaf->next;
+        if (next) {
+            __builtin_prefetch(next->next);
+            __builtin_prefetch(next->keys.data());
+        }
 
+        const Key* end = keys + n;
+        if (first != end && hi < end[-1]) {
+            // 범위가 이 리프에서 끝난다
+            end = std::upper_bound(first, end, hi);
+            visit(first, end - first);
+            return;
+        }
+        visit(first, end - first);
+
+        leaf = next;
+        if (leaf) {
+            keys = SortedKeys(leaf, scratch, n);
+            first = keys;
+        }
+    }
+}
+
+
+// CountRange function: Counts keys in [lo, hi].
+template<typename Key>
+size_t Bplustree<Key>::CountRange(const Key& lo, const Key& hi) const {
+    size_t count = 0;
+    ForEachRun(lo, hi, [&](const Key*, size_t n) { count += n; });
+    return count;
+}
+
+
+// SumRange function: Sums keys in [lo, hi].
+template<typename Key>
+Key Bplustree<Key>::SumRange(const Key& lo, const Key& hi) const {
+    Key sum{};
+    ForEachRun(lo, hi, [&](const Key* keys, size_t n) {
+        if constexpr (std::is_same<Key, uint64_t>::value) {
+            sum += SumKeys(keys, n);
+        } else {
+            for (size_t i = 0; i < n; i++) sum += keys[i];
+        }
+    });
+    return sum;
+}
+
+
+// MinMaxRange function: Leaves are sorted, so only the ends of each run are read.
+template<typename Key>
+bool Bplustree<Key>::MinMaxRange(const Key& lo, const Key& hi, Key& min_key, Key& max_key) const {
+    bool found = false;
+    ForEachRun(lo, hi, [&](const Key* keys, size_t n) {
+        if (n == 0) return;
+        if (!found) {
+            min_key = keys[0];
+            found = true;
+        }
+        max_key = keys[n - 1];
+    });
+    return found;
+}
+
+
+// CountMasked function: Filtered count with a SIMD compare kernel.
+template<typename Key>
+size_t Bplustree<Key>::CountMasked(const Key& lo, const Key& hi, uint64_t mask, uint64_t value) const {
+    size_t count = 0;
+    ForEachRun(lo, hi, [&](const Key* keys, size_t n) {
+        if constexpr (std::is_same<Key, uint64_t>::value) {
+            count += CountKeysMasked(keys, n, mask, value);
+        } else {
+            for (size_t i = 0; i < n; i++) count += ((uint64_t)keys[i] & mask) == value;
+        }
+    });
+    return count;
+}
+
+
+// CountIf function: Filtered count with an arbitrary predicate (branch-free accumulation).
+template<typename Key>
+template<typename Pred>
+size_t Bplustree<Key>::CountIf(const Key& lo, const Key& hi, Pred pred) const {
+    size_t count = 0;
+    ForEachRun(lo, hi, [&](const Key* keys, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            count += pred(keys[i]) ? 1 : 0;
+        }
+    });
+    return count;
+}
+
+
+// Delete function: Removes a key from the B+ Tree.
+template<typename Key>
+bool Bplustree<Key>::Delete(const Key& key) {
+    if (bloom && !bloom->MayContain(key)) {
+        return false; // 한 번도 삽입된 적 없는 key
+    }
+    // 1. 트리를 바꾸기 전에 먼저 로그에 남긴다. 없는 key의 삭제는 남기지 않는다
+    if (wal) {
+        if (!ContainsRange(key, key)) {
+            return false;
+        }
+        LogUpdate(WAL_DELETE, key);
+    }
+
+    // 2. 같은 key의 복사본을 모두 지운다
+    size_t removed = EraseRange(key, key);
+    if (removed == 0) {
+        return false; // key가 없으면 삭제 실패
+    }
+    if (hot_cache) hot_cache->Update(key, false);
     return true;
-    // To be implemented by students
 }
 
 
-// InsertInternal function: Helper function to insert a key into an internal node.
+// DeleteRange function: Removes every key in [lo, hi] from the B+ Tree.
+template<typename Key>
+size_t Bplustree<Key>::DeleteRange(const Key& lo, const Key& hi) {
+    // 트리를 바꾸기 전에 먼저 로그에 남긴다. 빈 범위의 삭제는 남기지 않는다
+    if (wal) {
+        if (!ContainsRange(lo, hi)) {
+            return 0;
+        }
+        LogUpdate(WAL_DELETE_RANGE, lo, hi);
+    }
+    size_t removed = EraseRange(lo, hi);
+    if (removed > 0 && hot_cache) hot_cache->InvalidateRange(lo, hi);
+    return removed;
+}
+
+
+// EraseRange function: Removes [lo, hi] with one top-down pass and repairs the tree bottom-up.
+template<typename Key>
+size_t Bplustree<Key>::EraseRange(const Key& lo, const Key& hi) {
+    if (hi < lo) {
+        return 0;
+    }
+
+    // 1. 범위 바로 앞의 리프를 찾는다 (삭제되는 리프들을 next 체인에서 떼어내기 위해, DeleteInternal과 같은 lower_bound 규칙)
+    LeafNode* prev = nullptr;
+    Node* left = nullptr;
+    Node* current = root;
+    while (!current->is_leaf) {
+        InternalNode* internal = current->as_internal();
+        int idx = std::lower_bound(internal->keys.begin(), internal->keys.end(), lo) - internal->keys.begin();
+        if (idx > 0) {
+            left = internal->children[idx - 1];
+        }
+        current = internal->children[idx];
+    }
+    if (left) {
+        while (!left->is_leaf) {
+            left = left->as_internal()->children.back();
+        }
+        prev = left->as_leaf();
+    }
+
+    // 2. 범위에 걸친 노드만 방문하면서 삭제
+    size_t removed = 0;
+    if (DeleteInternal(root, lo, hi, prev, removed)) {
+        root = new LeafNode(); // 모든 키가 지워졌다
+        learned_stale = true;
+    }
+
+    // 3. 자식이 하나뿐인 root는 한 단계씩 줄인다
+    while (!root->is_leaf && root->as_internal()->children.size() == 1) {
+        Node* child = root->as_internal()->children[0];
+        delete root;
+        root = child;
+    }
+    return removed;
+}
+
+
+// InsertInternal function: Helper function to insert a key into the subtree rooted at 'current'.
+// If 'current' splits, the new right sibling and its separator key are returned in 'new_child' / 'new_key'.
 template<typename Key>
 void Bplustree<Key>::InsertInternal(Node* current, const Key& key, Node*& new_child, Key& new_key) {
     // TODO: Implement internal node insertion logic here.
-        InternalNode* internal = current->as_internal();
+    new_child = nullptr;
+
+    if (current->is_leaf) {
+        LeafNode* leaf = current->as_leaf();
+
+        // 1. Leaf에 key 삽입 (buffer가 있으면 뒤에 붙이기만 하고, 가득 차면 한 번에 병합)
+        if (leaf_buffer > 0) {
+            leaf->buffer.push_back(key);
+            if (leaf->buffer.size() >= leaf_buffer) {
+                MergeBuffer(leaf);
+            }
+        } else {
+            auto it = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
+            leaf->keys.insert(it, key);
+        }
 
-    // 1. key가 들어갈 위치 찾기 (lower_bound 이용)
+        // 2. Overflow 체크
+        if (leaf->keys.size() + leaf->buffer.size() < (size_t)degree) {
+            return; // Overflow 안 났으면 끝
+        }
+        MergeBuffer(leaf);
+
+        // 3. Overflow 났으면 Leaf Split
+        LeafNode* new_leaf = new LeafNode();
+        int mid = (degree + 1) / 2;
+
+        // keys를 반으로 나눔
+        new_leaf->keys.assign(leaf->keys.begin() + mid, leaf->keys.end());
+        leaf->keys.resize(mid);
+
+        // next 포인터 연결
+        new_leaf->next = leaf->next;
+        leaf->next = new_leaf;
+
+        // 4. 새 리프의 첫 번째 키를 부모로 올림 (문자열 key는 두 리프를 가르는 가장 짧은 prefix만)
+        new_child = new_leaf;
+        new_key = SeparatorKey(leaf->keys.back(), new_leaf->keys[0]);
+
+        // learned layer에도 새 리프의 경계를 등록
+        if constexpr (std::is_arithmetic<Key>::value) {
+            if (learned && !learned_stale) {
+                learned->Insert(new_key, new_leaf, leaf);
+            }
+        }
+        return;
+    }
+
+    InternalNode* internal = current->as_internal();
+
+    // 1. key가 내려갈 자식 찾기 (upper_bound 이용)
     auto it = std::upper_bound(internal->keys.begin(), internal->keys.end(), key);
     int idx = it - internal->keys.begin();
 
-    // 2. children에 new_child 삽입
-    internal->keys.insert(internal->keys.begin() + idx, new_key);
-    internal->children.insert(internal->children.begin() + idx + 1, new_child);
+    Node* split_child = nullptr;
+    Key split_key{};
+    InsertInternal(internal->children[idx], key, split_child, split_key);
+    if (!split_child) {
+        return; // 자식이 split 되지 않았으면 끝
+    }
+
+    // 2. 자식이 split 됐으면 새 key와 child 등록
+    internal->keys.insert(internal->keys.begin() + idx, split_key);
+    internal->children.insert(internal->children.begin() + idx + 1, split_child);
 
     // 3. Overflow 체크
     if (internal->keys.size() < degree) {
         return; // 아직 문제 없음
     }
 
-    // 4. InternalNode Split
+    // 4. InternalNode Split (가운데 key는 부모로 올라가므로 양쪽에 절반씩 남긴다)
     InternalNode* new_internal = new InternalNode();
-    int mid = (degree + 1) / 2;
+    int mid = internal->keys.size() / 2;
 
     // keys와 children 나누기
     new_internal->keys.assign(internal->keys.begin() + mid + 1, internal->keys.end());
@@ -328,112 +951,215 @@ void Bplustree<Key>::InsertInternal(Node* current, const Key& key, Node*& new_ch
     internal->keys.resize(mid);
     internal->children.resize(mid + 1);
 
-    new_child = new_internal;
-
-    // 루트였으면 새로운 루트 생성
-    if (current == root) {
-        InternalNode* new_root = new InternalNode();
-        new_root->keys.push_back(new_key);
-        new_root->children.push_back(internal);
-        new_root->children.push_back(new_internal);
-        root = new_root;
-        return;
-    }
-
-    // 부모에 다시 삽입 요청 (재귀적)
-    InsertInternal(root, new_key, new_child, new_key);
+    new_child = new_internal; // 부모가 등록하도록 위로 전달
     // To be implemented by students
 }
 
 
-// DeleteInternal function: Helper function to delete a key from an internal node.
+// DeleteInternal function: Helper function to delete [lo, hi] from a subtree.
 template<typename Key>
-bool Bplustree<Key>::DeleteInternal(Node* current, const Key& key) {
+bool Bplustree<Key>::DeleteInternal(Node* current, const Key& lo, const Key& hi, LeafNode*& prev, size_t& removed) {
     // TODO: Implement internal node deletion logic here.
-        if (current->is_leaf) {
-        return false;  // 리프 노드는 여기에 올 수 없다.
+    if (current->is_leaf) {
+        // 범위의 양 끝 리프: 해당 구간만 잘라낸다
+        LeafNode* leaf = current->as_leaf();
+        MergeBuffer(leaf);
+        auto first = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), lo);
+        auto last = std::upper_bound(first, leaf->keys.end(), hi);
+        removed += last - first;
+        leaf->keys.erase(first, last);
+
+        if (leaf->keys.empty() && leaf != root) {
+            if (prev) prev->next = leaf->next;
+            delete leaf;
+            learned_stale = true;
+            return true;
+        }
+        prev = leaf;
+        return false;
     }
 
-    InternalNode* internal_node = current->as_internal();
-    auto itr = std::lower_bound(internal_node->keys.begin(), internal_node->keys.end(), key);
+    InternalNode* internal = current->as_internal();
 
-    // 삭제하려는 키가 내부 노드에 없으면 리턴
-    if (itr == internal_node->keys.end() || *itr != key) {
-        return false;
+    // 1. lo, hi가 걸치는 자식의 범위 [first, last]
+    //    분리 키와 같은 중복 key는 왼쪽 자식에도 남아 있을 수 있으므로 lo는 lower_bound로 찾는다
+    size_t first = std::lower_bound(internal->keys.begin(), internal->keys.end(), lo) - internal->keys.begin();
+    size_t last = std::upper_bound(internal->keys.begin(), internal->keys.end(), hi) - internal->keys.begin();
+
+    // 2. 양 끝 자식은 재귀로 처리하고, 사이에 있는 자식은 키를 보지 않고 통째로 제거 (key 순서대로 방문)
+    bool first_gone = DeleteInternal(internal->children[first], lo, hi, prev, removed);
+    for (size_t i = first + 1; i < last; ++i) {
+        removed += FreeSubtree(internal->children[i], prev);
+    }
+    bool last_gone = last > first && DeleteInternal(internal->children[last], lo, hi, prev, removed);
+
+    // 3. 제거된 자식과 그 분리 키를 오른쪽부터 지운다
+    //    자식 i의 왼쪽 경계는 keys[i - 1]이고, 맨 앞 자식이 지워지면 다음 자식의 경계 키가 필요 없어진다
+    auto erase_child = [internal](size_t i) {
+        internal->children.erase(internal->children.begin() + i);
+        if (i > 0) {
+            internal->keys.erase(internal->keys.begin() + i - 1);
+        } else if (!internal->keys.empty()) {
+            internal->keys.erase(internal->keys.begin());
+        }
+    };
+    if (last_gone) {
+        erase_child(last);
+    }
+    if (last > first + 1) {
+        internal->children.erase(internal->children.begin() + first + 1, internal->children.begin() + last);
+        internal->keys.erase(internal->keys.begin() + first, internal->keys.begin() + last - 1);
+    }
+    if (first_gone) {
+        erase_child(first);
     }
 
-    // 삭제할 키 찾은 후 해당 자식 노드로 내려가기
-    int index = std::distance(internal_node->keys.begin(), itr);
-    Node* child = internal_node->children[index];
+    if (internal->children.empty()) {
+        delete internal;
+        return true;
+    }
 
-    // 1. 자식 노드가 리프 노드인 경우, 자식에서 키 삭제
-    if (child->is_leaf) {
-        LeafNode* leaf_node = child->as_leaf();
-        auto it_leaf = std::lower_bound(leaf_node->keys.begin(), leaf_node->keys.end(), key);
-        leaf_node->keys.erase(it_leaf);  // 리프에서 키 삭제
+    // 4. 범위가 있던 자리 주변의 underflow를 오른쪽부터 합치거나 재분배한다
+    size_t n = internal->children.size();
+    if (n >= 2) {
+        size_t hi_idx = std::min(first + 1, n - 2);
+        size_t lo_idx = first > 0 ? first - 1 : 0;
+        for (size_t j = hi_idx + 1; j-- > lo_idx;) {
+            if (j + 1 < internal->children.size()) {
+                Rebalance(internal, j, prev);
+            }
+        }
     }
+    return false;
+    // To be implemented by students
+}
 
-    // 2. 자식 노드가 내부 노드인 경우
-    else {
-        InternalNode* child_internal = child->as_internal();
-        bool success = DeleteInternal(child, key);  // 자식 노드에서 재귀적으로 삭제
 
-        // 자식 노드가 underflow 상태라면, 형제에서 키를 빌리거나 병합
-        if (!success || child_internal->keys.size() < (degree - 1) / 2) {
-            Node* sibling = nullptr;
-            bool is_left_sibling = false;
+// FreeSubtree function: Frees every node below 'node' and unlinks its leaves.
+template<typename Key>
+size_t Bplustree<Key>::FreeSubtree(Node* node, LeafNode*& prev) {
+    if (node->is_leaf) {
+        LeafNode* leaf = node->as_leaf();
+        size_t count = leaf->keys.size() + leaf->buffer.size();
+        if (prev) prev->next = leaf->next;
+        delete leaf;
+        learned_stale = true;
+        return count;
+    }
+    size_t count = 0;
+    for (Node* child : node->as_internal()->children) {
+        count += FreeSubtree(child, prev);
+    }
+    delete node;
+    return count;
+}
 
-            // 부모에서 형제 찾기
-            if (index > 0) {
-                sibling = internal_node->children[index - 1];
-                is_left_sibling = true;
-            } else if (index < internal_node->children.size() - 1) {
-                sibling = internal_node->children[index + 1];
-                is_left_sibling = false;
-            }
 
-            if (sibling) {
-                InternalNode* sibling_internal = sibling->as_internal();
-
-                // 형제에서 빌리기
-                if (sibling_internal->keys.size() > (degree - 1) / 2) {
-                    if (is_left_sibling) {
-                        child_internal->keys.insert(child_internal->keys.begin(), internal_node->keys[index - 1]);
-                        internal_node->keys[index - 1] = sibling_internal->keys.back();
-                        sibling_internal->keys.pop_back();
-                    } else {
-                        child_internal->keys.push_back(internal_node->keys[index]);
-                        internal_node->keys[index] = sibling_internal->keys.front();
-                        sibling_internal->keys.erase(sibling_internal->keys.begin());
-                    }
-                }
-                // 형제와 병합
-                else {
-                    if (is_left_sibling) {
-                        sibling_internal->keys.push_back(internal_node->keys[index - 1]);
-                        sibling_internal->keys.insert(sibling_internal->keys.end(), child_internal->keys.begin(), child_internal->keys.end());
-                        internal_node->keys.erase(internal_node->keys.begin() + index - 1);
-                        internal_node->children.erase(internal_node->children.begin() + index);
-                    } else {
-                        child_internal->keys.push_back(internal_node->keys[index]);
-                        child_internal->keys.insert(child_internal->keys.end(), sibling_internal->keys.begin(), sibling_internal->keys.end());
-                        internal_node->keys.erase(internal_node->keys.begin() + index);
-                        internal_node->children.erase(internal_node->children.begin() + index + 1);
-                    }
-                }
-            }
+// Rebalance function: Merges children i and i+1 if they fit in one node, otherwise redistributes their keys.
+template<typename Key>
+void Bplustree<Key>::Rebalance(InternalNode* parent, size_t i, LeafNode*& prev) {
+    size_t min_keys = (degree - 1) / 2;
+    Node* a = parent->children[i];
+    Node* b = parent->children[i + 1];
+
+    if (a->is_leaf) {
+        LeafNode* left = a->as_leaf();
+        LeafNode* right = b->as_leaf();
+        MergeBuffer(left);
+        MergeBuffer(right);
+        if (left->keys.size() >= min_keys && right->keys.size() >= min_keys) {
+            return;
+        }
+        learned_stale = true; // 리프 경계가 바뀐다
+        if (left->keys.size() + right->keys.size() < (size_t)degree) {
+            // 병합: right를 left에 합치고 right 제거
+            left->keys.insert(left->keys.end(), right->keys.begin(), right->keys.end());
+            left->next = right->next;
+            if (prev == right) prev = left;
+            delete right;
+            parent->keys.erase(parent->keys.begin() + i);
+            parent->children.erase(parent->children.begin() + i + 1);
+        } else {
+            // 재분배: 두 리프의 키를 반씩 나눈다
+            std::vector<Key> all(left->keys);
+            all.insert(all.end(), right->keys.begin(), right->keys.end());
+            size_t half = all.size() / 2;
+            left->keys.assign(all.begin(), all.begin() + half);
+            right->keys.assign(all.begin() + half, all.end());
+            parent->keys[i] = right->keys.front();
         }
+        return;
     }
 
-    return true;
-    // To be implemented by students
+    InternalNode* left = a->as_internal();
+    InternalNode* right = b->as_internal();
+    if (left->keys.size() >= min_keys && right->keys.size() >= min_keys) {
+        return;
+    }
+    if (left->keys.size() + right->keys.size() + 1 < (size_t)degree) {
+        // 병합: 부모의 분리 키를 내려서 하나의 노드로 합친다
+        left->keys.push_back(parent->keys[i]);
+        left->keys.insert(left->keys.end(), right->keys.begin(), right->keys.end());
+        left->children.insert(left->children.end(), right->children.begin(), right->children.end());
+        delete right;
+        parent->keys.erase(parent->keys.begin() + i);
+        parent->children.erase(parent->children.begin() + i + 1);
+    } else {
+        // 재분배: 분리 키를 포함해 다시 반으로 나누고 가운데 키를 부모로 올린다
+        std::vector<Key> keys(left->keys);
+        keys.push_back(parent->keys[i]);
+        keys.insert(keys.end(), right->keys.begin(), right->keys.end());
+        std::vector<Node*> children(left->children);
+        children.insert(children.end(), right->children.begin(), right->children.end());
+
+        size_t half = keys.size() / 2;
+        left->keys.assign(keys.begin(), keys.begin() + half);
+        parent->keys[i] = keys[half];
+        right->keys.assign(keys.begin() + half + 1, keys.end());
+        left->children.assign(children.begin(), children.begin() + half + 1);
+        right->children.assign(children.begin() + half + 1, children.end());
+    }
 }
 
 
+// MergeBuffer function: Sorts the buffered keys and merges them into the sorted key array in one pass.
+template<typename Key>
+void Bplustree<Key>::MergeBuffer(LeafNode* leaf) {
+    if (leaf->buffer.empty()) {
+        return;
+    }
+    std::sort(leaf->buffer.begin(), leaf->buffer.end());
+    size_t n = leaf->keys.size();
+    leaf->keys.insert(leaf->keys.end(), leaf->buffer.begin(), leaf->buffer.end());
+    std::inplace_merge(leaf->keys.begin(), leaf->keys.begin() + n, leaf->keys.end());
+    leaf->buffer.clear();
+}
+
+// SortedKeys function: Read-only sorted view of a leaf, merging a non-empty buffer into 'scratch'.
+template<typename Key>
+const Key* Bplustree<Key>::SortedKeys(const LeafNode* leaf, std::vector<Key>& scratch, size_t& n) const {
+    n = leaf->keys.size() + leaf->buffer.size();
+    if (leaf->buffer.empty()) {
+        return leaf->keys.data();
+    }
+    // 읽기 경로는 const (ParallelScan은 여러 worker가 동시에 읽는다) 이므로 리프를 바꾸지 않고 복사본에서 병합한다
+    std::vector<Key> buffered(leaf->buffer);
+    std::sort(buffered.begin(), buffered.end());
+    scratch.resize(n);
+    std::merge(leaf->keys.begin(), leaf->keys.end(), buffered.begin(), buffered.end(), scratch.begin());
+    return scratch.data();
+}
+
 // FindLeaf function: Traverses the B+ Tree from the root to find the leaf node that should contain the given key.
 template<typename Key>
 typename Bplustree<Key>::LeafNode* Bplustree<Key>::FindLeaf(const Key& key) const {
     // TODO: Implement the traversal logic to locate the correct leaf node.
+    if constexpr (std::is_arithmetic<Key>::value) {
+        if (learned && !learned_stale) {
+            return learned->Lookup(key); // 모델로 리프를 바로 예측
+        }
+    }
+
     Node* current = root;
 
     while (!current->is_leaf) {
@@ -447,6 +1173,243 @@ typename Bplustree<Key>::LeafNode* Bplustree<Key>::FindLeaf(const Key& key) cons
     // To be implemented by students
 }
 
+// FindFirstLeaf function: Descends to the leftmost leaf that may contain 'key', as EraseRange does.
+template<typename Key>
+typename Bplustree<Key>::LeafNode* Bplustree<Key>::FindFirstLeaf(const Key& key) const {
+    Node* current = root;
+
+    while (!current->is_leaf) {
+        InternalNode* internal = current->as_internal();
+        // 분리 키와 같은 key의 복사본이 왼쪽 자식에 남아 있을 수 있으므로 lower_bound로 내려간다
+        int idx = std::lower_bound(internal->keys.begin(), internal->keys.end(), key) - internal->keys.begin();
+        current = internal->children[idx];
+    }
+
+    return current->as_leaf();
+}
+
+// ContainsRange function: Looks for the first key >= lo, skipping leaves that hold only smaller keys.
+template<typename Key>
+bool Bplustree<Key>::ContainsRange(const Key& lo, const Key& hi) const {
+    if (hi < lo) {
+        return false;
+    }
+    std::vector<Key> scratch;
+    for (LeafNode* leaf = FindFirstLeaf(lo); leaf; leaf = leaf->next) {
+        size_t n;
+        const Key* keys = SortedKeys(leaf, scratch, n);
+        const Key* first = std::lower_bound(keys, keys + n, lo);
+        if (first != keys + n) {
+            return !(hi < *first);
+        }
+    }
+    return false;
+}
+
+// Freeze function: Collects the keys along the leaf chain and builds the read-optimized layout.
+template<typename Key>
+FrozenBplustree<Key> Bplustree<Key>::Freeze() const {
+    Node* current = root;
+    while (!current->is_leaf) {
+        current = current->as_internal()->children.front();
+    }
+
+    std::vector<Key> keys;
+    std::vector<Key> scratch;
+    for (LeafNode* leaf = current->as_leaf(); leaf; leaf = leaf->next) {
+        size_t n;
+        const Key* sorted = SortedKeys(leaf, scratch, n);
+        keys.insert(keys.end(), sorted, sorted + n);
+    }
+    return FrozenBplustree<Key>(keys);
+}
+
+// EnableLearnedIndex function: Creates the learned layer and fits it to the current leaves.
+template<typename Key>
+void Bplustree<Key>::EnableLearnedIndex(size_t epsilon) {
+    delete learned;
+    learned = new PiecewiseLinearIndex<Key, LeafNode*>(epsilon);
+    RetrainLearnedIndex();
+}
+
+// RetrainLearnedIndex function: Refits the whole learned layer from the leaf chain.
+template<typename Key>
+void Bplustree<Key>::RetrainLearnedIndex() {
+    if (!learned) {
+        return;
+    }
+
+    // 각 리프의 왼쪽 경계 (맨 왼쪽 리프는 가장 작은 key)를 FindLeaf와 같은 규칙으로 모은다
+    std::vector<Key> fences;
+    std::vector<LeafNode*> leaves;
+    std::vector<std::pair<Node*, Key>> stack{{root, Key{}}};
+    while (!stack.empty()) {
+        Node* node = stack.back().first;
+        Key fence = stack.back().second;
+        stack.pop_back();
+        if (node->is_leaf) {
+            fences.push_back(fence);
+            leaves.push_back(node->as_leaf());
+            continue;
+        }
+        InternalNode* internal = node->as_internal();
+        for (size_t i = internal->children.size(); i-- > 0;) {
+            stack.push_back({internal->children[i], i > 0 ? internal->keys[i - 1] : fence});
+        }
+    }
+    learned->Build(fences, leaves);
+    learned_stale = false;
+}
+
+// LearnedIndexBytes function: Memory of the learned layer.
+template<typename Key>
+size_t Bplustree<Key>::LearnedIndexBytes() const {
+    return learned ? learned->MemoryBytes() : 0;
+}
+
+// InternalNodeBytes function: Memory of all internal nodes (node + key/child arrays).
+template<typename Key>
+size_t Bplustree<Key>::InternalNodeBytes() const {
+    size_t bytes = 0;
+    std::vector<Node*> stack{root};
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        if (node->is_leaf) {
+            continue;
+        }
+        InternalNode* internal = node->as_internal();
+        bytes += sizeof(InternalNode) + internal->keys.capacity() * sizeof(Key) + internal->children.capacity() * sizeof(Node*);
+        stack.insert(stack.end(), internal->children.begin(), internal->children.end());
+    }
+    return bytes;
+}
+
+// MemoryUsage function: Walks every node and adds up its struct and arrays.
+template<typename Key>
+typename Bplustree<Key>::MemoryStats Bplustree<Key>::MemoryUsage() const {
+    MemoryStats stats = {};
+    size_t children = 0;
+    std::vector<std::pair<Node*, int>> stack{{root, 1}};
+    while (!stack.empty()) {
+        Node* node = stack.back().first;
+        int level = stack.back().second;
+        stack.pop_back();
+        stats.height = std::max(stats.height, level);
+        if (node->is_leaf) {
+            LeafNode* leaf = node->as_leaf();
+            size_t used = leaf->keys.size() + leaf->buffer.size();
+            size_t reserved = leaf->keys.capacity() + leaf->buffer.capacity();
+            stats.leaves++;
+            stats.keys += used;
+            stats.key_bytes += used * sizeof(Key);
+            stats.slack_bytes += (reserved - used) * sizeof(Key);
+            stats.header_bytes += sizeof(LeafNode);
+            stats.allocator_bytes += MallocOverhead(sizeof(LeafNode)) + MallocOverhead(leaf->keys.capacity() * sizeof(Key)) +
+                                     MallocOverhead(leaf->buffer.capacity() * sizeof(Key));
+            continue;
+        }
+        InternalNode* internal = node->as_internal();
+        stats.internal_nodes++;
+        children += internal->children.size();
+        stats.key_bytes += internal->keys.size() * sizeof(Key);
+        stats.pointer_bytes += internal->children.size() * sizeof(Node*);
+        stats.slack_bytes += (internal->keys.capacity() - internal->keys.size()) * sizeof(Key) +
+                             (internal->children.capacity() - internal->children.size()) * sizeof(Node*);
+        stats.header_bytes += sizeof(InternalNode);
+        stats.allocator_bytes += MallocOverhead(sizeof(InternalNode)) + MallocOverhead(internal->keys.capacity() * sizeof(Key)) +
+                                 MallocOverhead(internal->children.capacity() * sizeof(Node*));
+        for (Node* child : internal->children) {
+            stack.push_back({child, level + 1});
+        }
+    }
+    stats.leaf_fill = stats.leaves && degree > 1 ? (double)stats.keys / (stats.leaves * (degree - 1)) : 0.0;
+    stats.internal_fill = stats.internal_nodes ? (double)children / (stats.internal_nodes * degree) : 0.0;
+    stats.aux_bytes = LearnedIndexBytes() + (hot_cache ? hot_cache->MemoryBytes() : 0) + (bloom ? bloom->MemoryBytes() : 0);
+    stats.total_bytes = stats.key_bytes + stats.pointer_bytes + stats.slack_bytes + stats.header_bytes + stats.allocator_bytes + stats.aux_bytes;
+    return stats;
+}
+
+// EnableLeafBuffer function: Sets the buffer capacity; turning it off merges every pending buffer.
+template<typename Key>
+void Bplustree<Key>::EnableLeafBuffer(size_t capacity) {
+    leaf_buffer = capacity;
+    if (capacity > 0) {
+        return;
+    }
+    Node* current = root;
+    while (!current->is_leaf) {
+        current = current->as_internal()->children.front();
+    }
+    for (LeafNode* leaf = current->as_leaf(); leaf; leaf = leaf->next) {
+        MergeBuffer(leaf);
+    }
+}
+
+// EnableHotCache function: Creates or removes the front cache.
+template<typename Key>
+void Bplustree<Key>::EnableHotCache(size_t slots) {
+    delete hot_cache;
+    hot_cache = slots > 0 ? new HotKeyCache<Key>(slots) : nullptr;
+}
+
+// EnableBloomFilter function: Creates or removes the Bloom filter.
+template<typename Key>
+void Bplustree<Key>::EnableBloomFilter(int bits_per_key) {
+    delete bloom;
+    bloom = nullptr;
+    bloom_bits_per_key = bits_per_key;
+    if (bits_per_key > 0) {
+        RebuildBloomFilter();
+    }
+}
+
+// RebuildBloomFilter function: Sizes the filter for twice the current key count and adds every key.
+template<typename Key>
+void Bplustree<Key>::RebuildBloomFilter() {
+    Node* current = root;
+    while (!current->is_leaf) {
+        current = current->as_internal()->children.front();
+    }
+    LeafNode* first = current->as_leaf();
+
+    size_t count = 0;
+    for (LeafNode* leaf = first; leaf; leaf = leaf->next) {
+        count += leaf->keys.size() + leaf->buffer.size();
+    }
+    delete bloom;
+    bloom = new BlockedBloomFilter<Key>(std::max<size_t>(count * 2, 1024), bloom_bits_per_key);
+    for (LeafNode* leaf = first; leaf; leaf = leaf->next) {
+        for (const Key& key : leaf->keys) bloom->Add(key);
+        for (const Key& key : leaf->buffer) bloom->Add(key);
+    }
+}
+
+// AttachWal function: Starts logging updates to the given write-ahead log.
+template<typename Key>
+void Bplustree<Key>::AttachWal(Wal* wal) {
+    static_assert(std::is_integral<Key>::value, "the WAL stores integer keys");
+    this->wal = wal;
+}
+
+// Recover function: Replays a write-ahead log into the tree.
+template<typename Key>
+long Bplustree<Key>::Recover(const char* path) {
+    Wal* attached = wal;
+    wal = nullptr; // replay 중에는 다시 로그를 남기지 않는다
+    long count = Wal::Replay(path, [this](WalOp op, uint64_t key, uint64_t hi) {
+        if (op == WAL_INSERT) {
+            Insert(key);
+        } else if (op == WAL_DELETE) {
+            Delete(key);
+        } else {
+            DeleteRange(key, hi);
+        }
+    });
+    wal = attached;
+    return count;
+}
+
 // Print function: Public interface to print the B+ Tree structure.
 template<typename Key>
 void Bplustree<Key>::Print() const {
@@ -466,6 +1429,11 @@ void Bplustree<Key>::PrintRecursive(const Node* node, int level) const {
         std::cout << "[Leaf] ";
         for (const Key& key : leaf->keys)
             std::cout << key << " ";
+        if (!leaf->buffer.empty()) {
+            std::cout << "| ";
+            for (const Key& key : leaf->buffer)
+                std::cout << key << " ";
+        }
         std::cout << std::endl;
     } else {
         // Print internal node keys and recursively print children.
@@ -477,4 +1445,6 @@ void Bplustree<Key>::PrintRecursive(const Node* node, int level) const {
         for (const Node* child : internal->children)
             PrintRecursive(child, level + 1);
     }
-}
\ No newline at end of file
+}
+
+#endif
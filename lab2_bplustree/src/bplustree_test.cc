@@ -10,37 +10,54 @@
 #include <vector>
 #include <thread>
 #include <cstdio>
+#include <mutex>
+#include <unordered_map>
 
 #include "zipf.h"
 #include "latest-generator.h"
 #include "bplustree.h"
+#include "hybrid_index.h"
+#include "string_key.h"
+#include "kv_entry.h"
+#include "key_stream.h"
+
+// Key streams: by default the keys of every timed loop below are generated into a KeyStream first
+// (key_stream.h), so the reported times are index time only and the generator rate is printed on its
+// own. --inline-keys generates them inside the timed loops instead, as older versions of this driver did.
+static bool materialize_keys = true;
+static double generate_seconds = 0; // Generator time of the current benchmark (outside the timed loops)
+static size_t generated_keys = 0;
+
+// timedLoop function: Calls op(next(i)) for i in [0, n) and returns the time of the loop in µs.
+template<typename Next, typename Op>
+float timedLoop(const int n, Next next, Op op) {
+    if (!materialize_keys) {
+        auto start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            op((Key)next(i));
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 0.001;
+    }
+    KeyStream keys(n < 0 ? 0 : n, next);
+    generate_seconds += keys.GenerateSeconds();
+    generated_keys += keys.Size();
+    auto start = Clock::now();
+    for (size_t i = 0; i < keys.Size(); i++) {
+        op((Key)keys[i]);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 0.001;
+}
 
 void Zipfian(const int write, const int read, Bplustree<Key>& bpt) {
     // Zipfian distribution generator
     init_zipf_generator(0, write);
 
     // Insert keys following Zipfian distribution
-    auto w_start = Clock::now();
-    for (int i = 1; i <= write; ++i) {
-        Key key = nextValue() % write+1;        
-        bpt.Insert(key);
-    }
-    auto w_end = Clock::now();
+    float w_time = timedLoop(write, [&](int) { return nextValue() % write + 1; }, [&](Key key) { bpt.Insert(key); });
     std::cout << "After Insert\n";
 
-    // Calculate insertion time
-    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-
     // Search for keys following Zipfian distribution
-    auto r_start = Clock::now();
-    for (int i = 1; i <= read; ++i) {
-        Key key = nextValue() % read+1;
-        bpt.Contains(key);
-    }
-    auto r_end = Clock::now();
-
-    // Calculate search time
-    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    float r_time = timedLoop(read, [&](int) { return nextValue() % read + 1; }, [&](Key key) { bpt.Contains(key); });
 
     // Display results
     printf("\n[Zipfian] Insertion = %.2lf µs, Lookup = %.2lf µs\n", w_time, r_time);
@@ -53,25 +70,11 @@ void Uniform(const int write, const int read, Bplustree<Key>& bpt) {
     std::uniform_int_distribution<int> distr(1, write);
 
     // Insert random keys
-    auto w_start = Clock::now();
-    for (int i = 1; i <= write; ++i) {
-        bpt.Insert(distr(gen)+1);
-    }
-    auto w_end = Clock::now();
+    float w_time = timedLoop(write, [&](int) { return distr(gen) + 1; }, [&](Key key) { bpt.Insert(key); });
     std::cout << "After Insert\n";
 
-    // Calculate insertion time
-    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-
     // Search for random keys
-    auto r_start = Clock::now();
-    for (int i = 1; i <= read; ++i) {
-        bpt.Contains(distr(gen)+1);
-    }
-    auto r_end = Clock::now();
-
-    // Calculate search time
-    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    float r_time = timedLoop(read, [&](int) { return distr(gen) + 1; }, [&](Key key) { bpt.Contains(key); });
 
     // Display results
     printf("\n[Uniform] Insertion = %.2lf µs, Lookup = %.2lf µs\n", w_time, r_time);
@@ -79,25 +82,11 @@ void Uniform(const int write, const int read, Bplustree<Key>& bpt) {
 
 void RevSequential(const int write, const int read, Bplustree<Key>& bpt) {
     // Insert keys reverse sequentially
-    auto w_start = Clock::now();
-    for (int i = write; i > 0; i--) {
-        bpt.Insert(i);
-    }
-    auto w_end = Clock::now();
+    float w_time = timedLoop(write, [&](int i) { return write - i; }, [&](Key key) { bpt.Insert(key); });
     std::cout << "After Insert\n";
 
-    // Calculate insertion time
-    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-
     // Search for keys reverse sequentially
-    auto r_start = Clock::now();
-    for (int i = read; i > 0; i--) {
-        bpt.Contains(i);
-    }
-    auto r_end = Clock::now();
-
-    // Calculate search time
-    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    float r_time = timedLoop(read, [&](int i) { return read - i; }, [&](Key key) { bpt.Contains(key); });
 
     // Display results
     printf("\n[Rev-Sequential] Insertion = %.2lf µs, Lookup = %.2lf µs\n", w_time, r_time);
@@ -105,25 +94,11 @@ void RevSequential(const int write, const int read, Bplustree<Key>& bpt) {
 
 void Sequential(const int write, const int read, Bplustree<Key>& bpt) {
     // Insert keys sequentially
-    auto w_start = Clock::now();
-    for (int i = 1; i <= write; ++i) {
-        bpt.Insert(i);
-    }
-    auto w_end = Clock::now();
+    float w_time = timedLoop(write, [](int i) { return i + 1; }, [&](Key key) { bpt.Insert(key); });
     std::cout << "After Insert\n";
 
-    // Calculate insertion time
-    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-
     // Search for keys sequentially
-    auto r_start = Clock::now();
-    for (int i = 1; i <= read; ++i) {
-        bpt.Contains(i);
-    }
-    auto r_end = Clock::now();
-
-    // Calculate search time
-    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    float r_time = timedLoop(read, [](int i) { return i + 1; }, [&](Key key) { bpt.Contains(key); });
 
     // Display results
     printf("\n[Sequential] Insertion = %.2lf µs, Lookup = %.2lf µs\n", w_time, r_time);
@@ -134,27 +109,11 @@ void Zipfian_Delete(const int write, const int read, Bplustree<Key>& bpt) {
     init_zipf_generator(0, write);
 
     // Insert keys following Zipfian distribution
-    auto w_start = Clock::now();
-    for (int i = 1; i <= write; ++i) {
-        Key key = nextValue() % write+1;        
-        bpt.Insert(key);
-    }
-    auto w_end = Clock::now();
+    float w_time = timedLoop(write, [&](int) { return nextValue() % write + 1; }, [&](Key key) { bpt.Insert(key); });
     std::cout << "After Insert\n";
 
-    // Calculate insertion time
-    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-
     // Delete for keys following Zipfian distribution
-    auto r_start = Clock::now();
-    for (int i = 1; i <= read; ++i) {
-        Key key = nextValue() % read+1;
-        bpt.Delete(key);
-    }
-    auto r_end = Clock::now();
-
-    // Calculate search time
-    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    float r_time = timedLoop(read, [&](int) { return nextValue() % read + 1; }, [&](Key key) { bpt.Delete(key); });
 
     // Display results
     printf("\n[Zipfian Delete] Insertion = %.2lf µs, Deletion = %.2lf µs\n", w_time, r_time);
@@ -167,59 +126,771 @@ void Uniform_Delete(const int write, const int read, Bplustree<Key>& bpt) {
     std::uniform_int_distribution<int> distr(1, write);
 
     // Insert random keys
-    auto w_start = Clock::now();
-    for (int i = 1; i <= write; ++i) {
-        bpt.Insert(distr(gen)+1);
-    }
-    auto w_end = Clock::now();
+    float w_time = timedLoop(write, [&](int) { return distr(gen) + 1; }, [&](Key key) { bpt.Insert(key); });
     std::cout << "After Insert\n";
 
-    // Calculate insertion time
-    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-
     // Delete for random keys
+    float r_time = timedLoop(read, [&](int) { return distr(gen) + 1; }, [&](Key key) { bpt.Delete(key); });
+
+    // Display results
+    printf("\n[Uniform Delete] Insertion = %.2lf µs, Deletion = %.2lf µs\n", w_time, r_time);
+}
+
+void Uniform_Scan(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(0, write);
+
+    float w_time = timedLoop(write, [](int i) { return i + 1; }, [&](Key key) { bpt.Insert(key); });
+    printf("After Insert\n");
+    float r_time = timedLoop(read, [&](int) { return distr(gen) + 1; }, [&](Key key) { bpt.Scan(key, 1000); });
+
+    printf("\n[Uniform-Scan] Insertion = %.2lf µs, Lookup = %.2lf µs\n", w_time, r_time);
+}
+
+void WAL_Commit(const int write, const int read, Bplustree<Key> &bpt) {
+    // Durability windows to compare (0 = sync as soon as the previous group is on disk)
+    const long intervals[] = {0, 100, 500, 2000};
+    const int threads = 8;
+    const char* path = "wal_bench.log";
+
+    std::mutex tree_mu;
+    Key base = 0;
+    for (long interval : intervals) {
+        std::remove(path);
+        Wal wal(path, interval);
+        if (int err = wal.Error()) {
+            printf("[WAL] %s: %s\n", path, strerror(err));
+            return;
+        }
+        bpt.AttachWal(&wal);
+
+        // Concurrent writers: each update is logged, applied, then made durable
+        auto w_start = Clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                for (int i = t + 1; i <= write; i += threads) {
+                    {
+                        std::lock_guard<std::mutex> lock(tree_mu);
+                        bpt.Insert(base + i);
+                    }
+                    wal.Sync();
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        auto w_end = Clock::now();
+        bpt.AttachWal(nullptr);
+        base += write;
+        if (int err = wal.Error()) {
+            printf("[WAL] interval = %6ld µs, log failed: %s\n", interval, strerror(err));
+            continue;
+        }
+
+        float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+        uint64_t syncs = wal.SyncCount();
+        printf("[WAL] interval = %6ld µs, Insertion = %.2lf µs, %.0lf ops/sec, syncs = %lu, avg group = %.1lf\n",
+               interval, w_time, write / (w_time * 1e-6), (unsigned long)syncs,
+               syncs ? (double)write / syncs : 0.0);
+    }
+
+    // Replay the last log into a fresh tree as a restart would
+    Bplustree<Key> replica;
+    auto r_start = Clock::now();
+    long replayed = replica.Recover(path);
+    auto r_end = Clock::now();
+    std::remove(path);
+
+    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("\n[WAL] Recovery = %.2lf µs (%ld records)\n", r_time, replayed);
+}
+
+void Range_Delete(const int write, const int read, Bplustree<Key> &bpt) {
+    // TTL sweep: expire the oldest half of the keys, 'read' consecutive keys per sweep
+    const Key expire = write / 2;
+    const Key width = read > 0 ? read : 1;
+
+    for (int i = 1; i <= write; i++) {
+        bpt.Insert(i);
+    }
+    printf("After Insert\n");
+
+    // One Delete call per expired key
+    auto d_start = Clock::now();
+    for (Key key = 1; key <= expire; key++) {
+        bpt.Delete(key);
+    }
+    auto d_end = Clock::now();
+
+    // Same sweep with DeleteRange on a second tree
+    Bplustree<Key> swept;
+    for (int i = 1; i <= write; i++) {
+        swept.Insert(i);
+    }
     auto r_start = Clock::now();
-    for (int i = 1; i <= read; ++i) {
-        bpt.Delete(distr(gen)+1);
+    for (Key lo = 1; lo <= expire; lo += width) {
+        swept.DeleteRange(lo, std::min(lo + width - 1, expire));
     }
     auto r_end = Clock::now();
 
-    // Calculate search time
+    float d_time = std::chrono::duration_cast<std::chrono::nanoseconds>(d_end - d_start).count() * 0.001;
     float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("\n[Range Delete] Delete = %.2lf µs, DeleteRange = %.2lf µs (%lu keys expired)\n",
+           d_time, r_time, (unsigned long)expire);
+}
 
-    // Display results
-    printf("\n[Uniform Delete] Insertion = %.2lf µs, Deletion = %.2lf µs\n", w_time, r_time);
+// Aggregates count and sum of the visited keys (visitor for ParallelScan)
+struct CountSumVisitor {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    void operator()(const Key& key) { count++; sum += key; }
+    void Merge(const CountSumVisitor& other) { count += other.count; sum += other.sum; }
+};
+
+void Parallel_Scan(const int write, const int read, Bplustree<Key> &bpt) {
+    for (int i = 1; i <= write; i++) {
+        bpt.Insert(i);
+    }
+    printf("After Insert\n");
+
+    // Each round aggregates the whole key range 'read / 1000' times (at least once)
+    const int rounds = std::max(1, read / 1000);
+
+    // Baseline: single-threaded Scan that materializes the keys, then reduces
+    auto s_start = Clock::now();
+    uint64_t expected = 0;
+    for (int r = 0; r < rounds; r++) {
+        expected = 0;
+        for (Key key : bpt.Scan(1, write)) {
+            expected += key;
+        }
+    }
+    auto s_end = Clock::now();
+    float s_time = std::chrono::duration_cast<std::chrono::nanoseconds>(s_end - s_start).count() * 0.001;
+    printf("\n[Parallel-Scan] Scan + reduce     = %.2lf µs\n", s_time);
+
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= max_threads * 2; threads *= 2) {
+        CountSumVisitor result;
+        auto p_start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            result = bpt.ParallelScan(1, write, CountSumVisitor(), threads);
+        }
+        auto p_end = Clock::now();
+        float p_time = std::chrono::duration_cast<std::chrono::nanoseconds>(p_end - p_start).count() * 0.001;
+        printf("[Parallel-Scan] threads = %2d     = %.2lf µs (speedup %.2lfx)%s\n", threads, p_time,
+               s_time / p_time, result.sum == expected ? "" : " MISMATCH");
+    }
 }
 
-void Uniform_Scan(const int write, const int read, Bplustree<Key> &bpt) {
+void Range_Aggregate(const int write, const int read, Bplustree<Key> &bpt) {
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> distr(0, write);
+    const int width = std::max(1, write / 100); // Each query covers 1% of the keys
+    std::uniform_int_distribution<int> distr(1, std::max(1, write - width));
 
-    auto w_start = Clock::now();
-    for(int i = 1; i <= write; i++) {
-        //Key key = distr(gen)+1;
-        Key key = i;
+    for (int i = 1; i <= write; i++) {
+        bpt.Insert(i);
+    }
+    printf("After Insert\n");
+
+    std::vector<Key> los(read);
+    for (int i = 0; i < read; i++) {
+        los[i] = distr(gen);
+    }
+
+    // Baseline: Scan copies the keys out, then count/sum/min/max are computed over the copy
+    uint64_t check_scan = 0;
+    auto s_start = Clock::now();
+    for (int i = 0; i < read; i++) {
+        std::vector<Key> keys = bpt.Scan(los[i], width);
+        uint64_t sum = 0;
+        Key min_key = keys.empty() ? 0 : keys.front();
+        Key max_key = min_key;
+        for (Key key : keys) {
+            sum += key;
+            min_key = std::min(min_key, key);
+            max_key = std::max(max_key, key);
+        }
+        check_scan += keys.size() + sum + min_key + max_key;
+    }
+    auto s_end = Clock::now();
+
+    // Pushdown: the same aggregates computed on the leaves
+    uint64_t check_push = 0;
+    auto a_start = Clock::now();
+    for (int i = 0; i < read; i++) {
+        Key hi = los[i] + width - 1;
+        Key min_key = 0, max_key = 0;
+        bpt.MinMaxRange(los[i], hi, min_key, max_key);
+        check_push += bpt.CountRange(los[i], hi) + bpt.SumRange(los[i], hi) + min_key + max_key;
+    }
+    auto a_end = Clock::now();
+
+    // Filtered count: even keys
+    auto f_start = Clock::now();
+    size_t even = 0;
+    for (int i = 0; i < read; i++) {
+        even += bpt.CountMasked(los[i], los[i] + width - 1, 1, 0);
+    }
+    auto f_end = Clock::now();
+
+    float s_time = std::chrono::duration_cast<std::chrono::nanoseconds>(s_end - s_start).count() * 0.001;
+    float a_time = std::chrono::duration_cast<std::chrono::nanoseconds>(a_end - a_start).count() * 0.001;
+    float f_time = std::chrono::duration_cast<std::chrono::nanoseconds>(f_end - f_start).count() * 0.001;
+    printf("\n[Range-Aggregate] Scan + reduce = %.2lf µs, Pushdown = %.2lf µs, Filtered count = %.2lf µs (%lu)%s\n",
+           s_time, a_time, f_time, (unsigned long)even, check_scan == check_push ? "" : " MISMATCH");
+
+    // Duplicates of a separator key straddle two leaves; every aggregate has to see all of them
+    Bplustree<Key> dup(4);
+    for (int i = 0; i < 6; i++) {
+        dup.Insert(5);
+    }
+    dup.Insert(1);
+    dup.Insert(9);
+    Key min_key = 0, max_key = 0;
+    bool found = dup.MinMaxRange(5, 5, min_key, max_key);
+    size_t count = dup.CountRange(5, 5);
+    bool dup_ok = count == 6 && dup.SumRange(5, 5) == 30 && found && min_key == 5 && max_key == 5 &&
+                  dup.CountMasked(5, 5, 1, 1) == 6 && dup.DeleteRange(5, 5) == count;
+    printf("[Range-Aggregate] Duplicate keys across leaves: count = %lu%s\n", (unsigned long)count, dup_ok ? "" : " MISMATCH");
+}
+
+void Freeze_Lookup(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+
+    for (int i = 1; i <= write; i++) {
+        bpt.Insert(distr(gen) + 1);
+    }
+    auto f_start = Clock::now();
+    FrozenBplustree<Key> frozen = bpt.Freeze();
+    auto f_end = Clock::now();
+    printf("After Insert\n");
+
+    std::vector<Key> keys(read);
+    for (int i = 0; i < read; i++) {
+        keys[i] = distr(gen) + 1;
+    }
+
+    // Point lookups on both structures
+    size_t hits_tree = 0, hits_frozen = 0;
+    auto t_start = Clock::now();
+    for (Key key : keys) {
+        hits_tree += bpt.Contains(key);
+    }
+    auto t_end = Clock::now();
+    auto c_start = Clock::now();
+    for (Key key : keys) {
+        hits_frozen += frozen.Contains(key);
+    }
+    auto c_end = Clock::now();
+
+    // Short scans on both structures
+    auto ts_start = Clock::now();
+    for (int i = 0; i < read / 100; i++) {
+        bpt.Scan(keys[i], 1000);
+    }
+    auto ts_end = Clock::now();
+    auto cs_start = Clock::now();
+    for (int i = 0; i < read / 100; i++) {
+        frozen.Scan(keys[i], 1000);
+    }
+    auto cs_end = Clock::now();
+
+    float f_time = std::chrono::duration_cast<std::chrono::nanoseconds>(f_end - f_start).count() * 0.001;
+    float t_time = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count() * 0.001;
+    float c_time = std::chrono::duration_cast<std::chrono::nanoseconds>(c_end - c_start).count() * 0.001;
+    float ts_time = std::chrono::duration_cast<std::chrono::nanoseconds>(ts_end - ts_start).count() * 0.001;
+    float cs_time = std::chrono::duration_cast<std::chrono::nanoseconds>(cs_end - cs_start).count() * 0.001;
+    printf("\n[Freeze] Freeze = %.2lf µs, %lu keys, %.2lf bytes/key\n", f_time, (unsigned long)frozen.size(),
+           frozen.size() ? (double)frozen.MemoryBytes() / frozen.size() : 0.0);
+    printf("[Freeze] Lookup: Bplustree = %.2lf µs, Frozen = %.2lf µs%s\n", t_time, c_time,
+           hits_tree == hits_frozen ? "" : " MISMATCH");
+    printf("[Freeze] Scan:   Bplustree = %.2lf µs, Frozen = %.2lf µs\n", ts_time, cs_time);
+}
+
+void Learned_Lookup(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+
+    for (int i = 1; i <= write; i++) {
+        bpt.Insert(i);
+    }
+    printf("After Insert\n");
+
+    std::vector<Key> keys(read);
+    for (int i = 0; i < read; i++) {
+        keys[i] = distr(gen);
+    }
+
+    // Lookups through the internal nodes
+    size_t hits_tree = 0;
+    auto t_start = Clock::now();
+    for (Key key : keys) {
+        hits_tree += bpt.Contains(key);
+    }
+    auto t_end = Clock::now();
+
+    // Lookups through the learned layer
+    auto b_start = Clock::now();
+    bpt.EnableLearnedIndex();
+    auto b_end = Clock::now();
+    size_t hits_learned = 0;
+    auto l_start = Clock::now();
+    for (Key key : keys) {
+        hits_learned += bpt.Contains(key);
+    }
+    auto l_end = Clock::now();
+
+    // Random inserts with the layer kept up to date on every leaf split
+    Bplustree<Key> grown;
+    grown.EnableLearnedIndex();
+    std::vector<Key> inserted(write);
+    for (int i = 0; i < write; i++) {
+        inserted[i] = distr(gen);
+    }
+    auto g_start = Clock::now();
+    for (Key key : inserted) {
+        grown.Insert(key);
+    }
+    auto g_end = Clock::now();
+
+    // Every key must still be found, also when the new fence of a split equals an existing one:
+    // each block (in descending order) leaves two copies of 'dup' at the end of a leaf that lies left of
+    // another leaf starting with 'dup', then splits that leaf
+    size_t missing = 0;
+    for (Key key : inserted) {
+        missing += !grown.Contains(key);
+    }
+    Bplustree<Key> fenced(4);
+    fenced.EnableLearnedIndex();
+    const int blocks = std::max(1, write / 8);
+    for (int i = blocks; i >= 1; i--) {
+        Key dup = (Key)10 * i + 5;
+        for (int c = 0; c < 4; c++) {
+            fenced.Insert(dup);
+        }
+        fenced.Insert(dup + 1);
+        fenced.Insert(dup - 2);
+        fenced.Insert(dup - 1);
+    }
+    for (int i = 1; i <= blocks; i++) {
+        Key dup = (Key)10 * i + 5;
+        missing += !fenced.Contains(dup - 2) + !fenced.Contains(dup - 1) + !fenced.Contains(dup) + !fenced.Contains(dup + 1);
+    }
+
+    float t_time = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count() * 0.001;
+    float b_time = std::chrono::duration_cast<std::chrono::nanoseconds>(b_end - b_start).count() * 0.001;
+    float l_time = std::chrono::duration_cast<std::chrono::nanoseconds>(l_end - l_start).count() * 0.001;
+    float g_time = std::chrono::duration_cast<std::chrono::nanoseconds>(g_end - g_start).count() * 0.001;
+    printf("\n[Learned] Lookup: FindLeaf = %.2lf µs, Learned = %.2lf µs (train %.2lf µs)%s\n",
+           t_time, l_time, b_time, hits_tree == hits_learned ? "" : " MISMATCH");
+    printf("[Learned] Memory: internal nodes = %lu bytes, learned layer = %lu bytes\n",
+           (unsigned long)bpt.InternalNodeBytes(), (unsigned long)bpt.LearnedIndexBytes());
+    printf("[Learned] Random insert with incremental retrain = %.2lf µs%s\n", g_time, missing == 0 ? "" : " MISMATCH");
+}
+
+void Leaf_Buffer(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+
+    std::vector<Key> keys(write);
+    for (int i = 0; i < write; i++) {
+        keys[i] = distr(gen);
+    }
+
+    // Wide leaves, where the sorted insert shift dominates
+    const int degree = 512;
+    Bplustree<Key> sorted(degree);
+    auto s_start = Clock::now();
+    for (Key key : keys) {
+        sorted.Insert(key);
+    }
+    auto s_end = Clock::now();
+
+    // Same keys with a 32-key append buffer in every leaf
+    Bplustree<Key> buffered(degree);
+    buffered.EnableLeafBuffer(32);
+    auto b_start = Clock::now();
+    for (Key key : keys) {
+        buffered.Insert(key);
+    }
+    auto b_end = Clock::now();
+    printf("After Insert\n");
+
+    // Lookups have to check the buffer as well; both trees get the same keys, so the hits must match
+    std::vector<Key> lookups(read);
+    for (int i = 0; i < read; i++) {
+        lookups[i] = distr(gen);
+    }
+    size_t hits_sorted = 0, hits_buffered = 0;
+    auto ls_start = Clock::now();
+    for (Key key : lookups) {
+        hits_sorted += sorted.Contains(key);
+    }
+    auto ls_end = Clock::now();
+    auto lb_start = Clock::now();
+    for (Key key : lookups) {
+        hits_buffered += buffered.Contains(key);
+    }
+    auto lb_end = Clock::now();
+
+    // Scans must still return the same keys in order
+    bool same = sorted.Scan(0, write) == buffered.Scan(0, write);
+
+    float s_time = std::chrono::duration_cast<std::chrono::nanoseconds>(s_end - s_start).count() * 0.001;
+    float b_time = std::chrono::duration_cast<std::chrono::nanoseconds>(b_end - b_start).count() * 0.001;
+    float ls_time = std::chrono::duration_cast<std::chrono::nanoseconds>(ls_end - ls_start).count() * 0.001;
+    float lb_time = std::chrono::duration_cast<std::chrono::nanoseconds>(lb_end - lb_start).count() * 0.001;
+    printf("\n[Leaf-Buffer] degree = %d, Insertion: sorted = %.2lf µs, buffered = %.2lf µs%s\n",
+           degree, s_time, b_time, same ? "" : " MISMATCH");
+    printf("[Leaf-Buffer] Lookup: sorted = %.2lf µs (%lu hits), buffered = %.2lf µs (%lu hits)%s\n",
+           ls_time, (unsigned long)hits_sorted, lb_time, (unsigned long)hits_buffered,
+           hits_sorted == hits_buffered ? "" : " MISMATCH");
+}
+
+void Hot_Cache(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+
+    for (int i = 1; i <= write; i++) {
+        bpt.Insert(distr(gen));
+    }
+    printf("After Insert\n");
+
+    // Skewed and uniform lookup streams, generated up front
+    init_zipf_generator(0, write);
+    std::vector<Key> zipf_keys(read), uniform_keys(read);
+    for (int i = 0; i < read; i++) {
+        zipf_keys[i] = nextValue() % write + 1;
+        uniform_keys[i] = distr(gen);
+    }
+
+    auto run = [&](const std::vector<Key>& keys, size_t& hits) {
+        hits = 0;
+        auto start = Clock::now();
+        for (Key key : keys) {
+            hits += bpt.Contains(key);
+        }
+        auto end = Clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 0.001;
+    };
+
+    size_t zipf_hits, uniform_hits, zipf_cached_hits, uniform_cached_hits;
+    double z_time = run(zipf_keys, zipf_hits);
+    double u_time = run(uniform_keys, uniform_hits);
+
+    bpt.EnableHotCache();
+    double zc_time = run(zipf_keys, zipf_cached_hits);
+    double zipf_rate = bpt.HotCache()->HitRate();
+    bpt.HotCache()->ResetStats();
+    double uc_time = run(uniform_keys, uniform_cached_hits);
+    double uniform_rate = bpt.HotCache()->HitRate();
+
+    // Cached answers must follow Delete / Insert of the hottest keys
+    size_t stale = 0;
+    for (int i = 0; i < read && i < 1000; i++) {
+        bpt.Delete(zipf_keys[i]);
+        stale += bpt.Contains(zipf_keys[i]);
+    }
+    for (int i = 0; i < read && i < 1000; i++) {
+        bpt.Insert(zipf_keys[i]);
+        stale += !bpt.Contains(zipf_keys[i]);
+    }
+
+    bool same = zipf_hits == zipf_cached_hits && uniform_hits == uniform_cached_hits && stale == 0;
+    printf("\n[Hot-Cache] Zipfian lookup: no cache = %.2lf µs, cache = %.2lf µs (hit rate %.1lf%%)%s\n",
+           z_time, zc_time, zipf_rate * 100, same ? "" : " MISMATCH");
+    printf("[Hot-Cache] Uniform lookup: no cache = %.2lf µs, cache = %.2lf µs (hit rate %.1lf%%)\n",
+           u_time, uc_time, uniform_rate * 100);
+}
+
+void Bloom_Filter(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+    std::uniform_int_distribution<Key> wide(1, (Key)write * 4); // mostly keys that were never inserted
+
+    // Same keys into a plain index and one whose filter grows with it from the start
+    Bplustree<Key> filtered;
+    filtered.EnableBloomFilter();
+    for (int i = 1; i <= write; i++) {
+        Key key = distr(gen);
         bpt.Insert(key);
+        filtered.Insert(key);
+    }
+    printf("After Insert\n");
+
+    std::vector<Key> keys(read);
+    for (int i = 0; i < read; i++) {
+        keys[i] = wide(gen);
+    }
+
+    size_t hits_plain = 0, hits_filtered = 0, false_positives = 0;
+    auto p_start = Clock::now();
+    for (Key key : keys) {
+        hits_plain += bpt.Contains(key);
+    }
+    auto p_end = Clock::now();
+    auto f_start = Clock::now();
+    for (Key key : keys) {
+        hits_filtered += filtered.Contains(key);
+    }
+    auto f_end = Clock::now();
+    for (Key key : keys) {
+        false_positives += filtered.BloomFilter()->MayContain(key) && !bpt.Contains(key);
+    }
+
+    // Deletes of (mostly) absent keys
+    size_t del_plain = 0, del_filtered = 0;
+    auto pd_start = Clock::now();
+    for (Key key : keys) {
+        del_plain += bpt.Delete(key);
+    }
+    auto pd_end = Clock::now();
+    auto fd_start = Clock::now();
+    for (Key key : keys) {
+        del_filtered += filtered.Delete(key);
+    }
+    auto fd_end = Clock::now();
+
+    float p_time = std::chrono::duration_cast<std::chrono::nanoseconds>(p_end - p_start).count() * 0.001;
+    float f_time = std::chrono::duration_cast<std::chrono::nanoseconds>(f_end - f_start).count() * 0.001;
+    float pd_time = std::chrono::duration_cast<std::chrono::nanoseconds>(pd_end - pd_start).count() * 0.001;
+    float fd_time = std::chrono::duration_cast<std::chrono::nanoseconds>(fd_end - fd_start).count() * 0.001;
+    size_t negatives = read - hits_plain;
+    printf("\n[Bloom] Lookup: plain = %.2lf µs, filtered = %.2lf µs (%lu of %d keys absent)%s\n",
+           p_time, f_time, (unsigned long)negatives, read,
+           hits_plain == hits_filtered && del_plain == del_filtered ? "" : " MISMATCH");
+    printf("[Bloom] Delete: plain = %.2lf µs, filtered = %.2lf µs\n", pd_time, fd_time);
+    printf("[Bloom] Filter: %lu bytes for %lu keys, false positive rate = %.2lf%%\n",
+           (unsigned long)filtered.BloomFilter()->MemoryBytes(), (unsigned long)filtered.BloomFilter()->Capacity(),
+           negatives ? 100.0 * false_positives / negatives : 0.0);
+}
+
+void Hybrid_Index(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+
+    HybridIndex<Key, Bplustree<Key>> hybrid;
+    auto w_start = Clock::now();
+    for (int i = 1; i <= write; i++) {
+        hybrid.Insert(distr(gen));
     }
     auto w_end = Clock::now();
+    // The ordered side alone, for comparison
+    Bplustree<Key>& ordered = hybrid.OrderedIndex();
     printf("After Insert\n");
-    auto r_start = Clock::now();
-    for(int i = 1; i <= read; i++) {
-        Key key = distr(gen)+1;
-        bpt.Scan(key, 1000);
+
+    std::vector<Key> keys(read);
+    for (int i = 0; i < read; i++) {
+        keys[i] = distr(gen);
     }
-    auto r_end = Clock::now();
 
-    float r_time, w_time;
-    r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
-    w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
-    printf("\n[Uniform-Scan] Insertion = %.2lf µs, Lookup = %.2lf µs\n", w_time, r_time);
+    size_t hits_ordered = 0, hits_hybrid = 0;
+    auto o_start = Clock::now();
+    for (Key key : keys) {
+        hits_ordered += ordered.Contains(key);
+    }
+    auto o_end = Clock::now();
+    auto h_start = Clock::now();
+    for (Key key : keys) {
+        hits_hybrid += hybrid.Contains(key);
+    }
+    auto h_end = Clock::now();
+
+    // Scans still come from the ordered side, so they must see every update
+    for (int i = 0; i < read / 10; i++) {
+        hybrid.Delete(keys[i]);
+    }
+    std::vector<Key> scanned = hybrid.Scan(0, write);
+    bool same = hits_ordered == hits_hybrid && scanned.size() == hybrid.size() &&
+                std::is_sorted(scanned.begin(), scanned.end());
+
+    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+    float o_time = std::chrono::duration_cast<std::chrono::nanoseconds>(o_end - o_start).count() * 0.001;
+    float h_time = std::chrono::duration_cast<std::chrono::nanoseconds>(h_end - h_start).count() * 0.001;
+    printf("\n[Hybrid] Insertion (both sides) = %.2lf µs\n", w_time);
+    printf("[Hybrid] Lookup: Bplustree = %.2lf µs, hash = %.2lf µs%s\n", o_time, h_time, same ? "" : " MISMATCH");
+    printf("[Hybrid] Hash side: %lu bytes for %lu keys (%.2lf bytes/key)\n", (unsigned long)hybrid.HashBytes(),
+           (unsigned long)hybrid.size(), hybrid.size() ? (double)hybrid.HashBytes() / hybrid.size() : 0.0);
+}
+
+// String IDs of the form "user" + 16 hex digits. The shared "user" leaves 4 distinguishing bytes in the
+// abbreviated key, so keys that agree on those still fall through to the full byte compare.
+std::string makeStringId(uint64_t n) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "user%016llx", (unsigned long long)(n * 0x9E3779B97F4A7C15ull));
+    return buf;
+}
+
+void String_Keys(const int write, const int read, Bplustree<Key> &bpt) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, write);
+    std::uniform_int_distribution<int> probe_distr(1, 2 * write); // 절반은 없는 key
+
+    std::vector<std::string> ids(write);
+    for (std::string& id : ids) {
+        id = makeStringId(distr(gen));
+    }
+    std::vector<std::string> probes(read);
+    for (std::string& probe : probes) {
+        probe = makeStringId(probe_distr(gen));
+    }
+
+    // 1. std::string key: 노드마다 문자열을 따로 할당하고, 비교는 매번 바이트 비교
+    Bplustree<std::string> plain;
+    auto pw_start = Clock::now();
+    for (const std::string& id : ids) {
+        plain.Insert(id);
+    }
+    auto pw_end = Clock::now();
+    size_t hits_plain = 0;
+    auto pr_start = Clock::now();
+    for (const std::string& probe : probes) {
+        hits_plain += plain.Contains(probe);
+    }
+    auto pr_end = Clock::now();
+
+    // 2. StringKey: 바이트는 arena에, 비교는 앞 8바이트 정수 비교부터
+    KeyArena arena;
+    Bplustree<StringKey> abbreviated;
+    auto aw_start = Clock::now();
+    for (const std::string& id : ids) {
+        abbreviated.Insert(arena.Make(id));
+    }
+    auto aw_end = Clock::now();
+    size_t hits_abbreviated = 0;
+    auto ar_start = Clock::now();
+    for (const std::string& probe : probes) {
+        hits_abbreviated += abbreviated.Contains(StringKey(probe.data(), probe.size()));
+    }
+    auto ar_end = Clock::now();
+    printf("After Insert\n");
+
+    // 두 구조는 같은 key를 같은 순서로 돌려줘야 한다
+    std::vector<std::string> plain_scan = plain.Scan(std::string(), write);
+    std::vector<StringKey> abbreviated_scan = abbreviated.Scan(StringKey(), write);
+    bool same = hits_plain == hits_abbreviated && plain_scan.size() == abbreviated_scan.size();
+    for (size_t i = 0; same && i < plain_scan.size(); i++) {
+        same = plain_scan[i] == abbreviated_scan[i].ToString();
+    }
+
+    float pw_time = std::chrono::duration_cast<std::chrono::nanoseconds>(pw_end - pw_start).count() * 0.001;
+    float pr_time = std::chrono::duration_cast<std::chrono::nanoseconds>(pr_end - pr_start).count() * 0.001;
+    float aw_time = std::chrono::duration_cast<std::chrono::nanoseconds>(aw_end - aw_start).count() * 0.001;
+    float ar_time = std::chrono::duration_cast<std::chrono::nanoseconds>(ar_end - ar_start).count() * 0.001;
+    printf("\n[String] std::string: Insertion = %.2lf µs, Lookup = %.2lf µs\n", pw_time, pr_time);
+    printf("[String] StringKey  : Insertion = %.2lf µs, Lookup = %.2lf µs%s\n", aw_time, ar_time, same ? "" : " MISMATCH");
+    printf("[String] Arena: %lu key bytes in %lu bytes of blocks\n", (unsigned long)arena.BytesUsed(),
+           (unsigned long)arena.MemoryBytes());
+}
+
+// Payload of version 'version' of 'key': 'size' bytes, different for every key and version
+void fillValue(std::string& value, Key key, int version, size_t size) {
+    value.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        value[i] = (char)('a' + (key + version + i) % 26);
+    }
+}
+
+void KV_Store(const int write, const int read, Bplustree<Key> &bpt) {
+    typedef KVEntry<Key, PackedValue<16>> Entry;
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> distr(1, std::max(write / 2, 1)); // 절반 정도는 덮어쓰기
+    std::uniform_int_distribution<int> probe_distr(1, write);            // 절반 정도는 없는 key
+
+    std::vector<Key> keys(write);
+    for (Key& key : keys) key = distr(gen);
+    std::vector<Key> probes(read);
+    for (Key& probe : probes) probe = probe_distr(gen);
+    const int scans = std::max(read / 100, 1);
+
+    for (size_t size : {(size_t)8, (size_t)100}) {
+        std::string value;
+
+        // 1. key는 Bplustree, 값은 따로 std::unordered_map에: 연산마다 두 번 찾는다
+        Bplustree<Key> index;
+        std::unordered_map<Key, std::string> values;
+        auto sw_start = Clock::now();
+        for (int i = 0; i < write; i++) {
+            fillValue(value, keys[i], i, size);
+            if (!index.Contains(keys[i])) index.Insert(keys[i]); // 트리는 중복 key를 허용한다
+            values[keys[i]] = value;
+        }
+        auto sw_end = Clock::now();
+        uint64_t sum_split = 0;
+        auto sr_start = Clock::now();
+        for (Key probe : probes) {
+            if (index.Contains(probe)) {
+                const std::string& v = values.find(probe)->second;
+                sum_split += (unsigned char)v[0] + v.size();
+            }
+        }
+        auto sr_end = Clock::now();
+        auto ss_start = Clock::now();
+        for (int i = 0; i < scans; i++) {
+            for (Key key : index.Scan(probes[i], 100)) {
+                const std::string& v = values.find(key)->second;
+                sum_split += (unsigned char)v[v.size() - 1];
+            }
+        }
+        auto ss_end = Clock::now();
+
+        // 2. Bplustree<KVEntry>: 값은 노드 안에 (16바이트 초과면 value log의 offset), Upsert / Find 한 번
+        ValueLog log;
+        Bplustree<Entry> kv;
+        auto kw_start = Clock::now();
+        for (int i = 0; i < write; i++) {
+            fillValue(value, keys[i], i, size);
+            kv.Upsert(Entry(keys[i], PackedValue<16>(value.data(), value.size(), log)));
+        }
+        auto kw_end = Clock::now();
+        uint64_t sum_kv = 0;
+        auto kr_start = Clock::now();
+        for (Key probe : probes) {
+            const Entry* entry = kv.Find(Entry(probe));
+            if (entry) {
+                sum_kv += (unsigned char)entry->value.Data(log)[0] + entry->value.Size();
+            }
+        }
+        auto kr_end = Clock::now();
+        auto ks_start = Clock::now();
+        for (int i = 0; i < scans; i++) {
+            kv.ScanVisit(Entry(probes[i]), 100, [&](const Entry& entry) {
+                sum_kv += (unsigned char)entry.value.Data(log)[entry.value.Size() - 1];
+            });
+        }
+        auto ks_end = Clock::now();
+
+        float sw_time = std::chrono::duration_cast<std::chrono::nanoseconds>(sw_end - sw_start).count() * 0.001;
+        float sr_time = std::chrono::duration_cast<std::chrono::nanoseconds>(sr_end - sr_start).count() * 0.001;
+        float ss_time = std::chrono::duration_cast<std::chrono::nanoseconds>(ss_end - ss_start).count() * 0.001;
+        float kw_time = std::chrono::duration_cast<std::chrono::nanoseconds>(kw_end - kw_start).count() * 0.001;
+        float kr_time = std::chrono::duration_cast<std::chrono::nanoseconds>(kr_end - kr_start).count() * 0.001;
+        float ks_time = std::chrono::duration_cast<std::chrono::nanoseconds>(ks_end - ks_start).count() * 0.001;
+        printf("\n[KV %3luB] Index + map: Upsert = %.2lf µs, Get = %.2lf µs, Scan = %.2lf µs\n", (unsigned long)size,
+               sw_time, sr_time, ss_time);
+        printf("[KV %3luB] KVEntry    : Upsert = %.2lf µs, Get = %.2lf µs, Scan = %.2lf µs%s\n", (unsigned long)size,
+               kw_time, kr_time, ks_time, sum_split == sum_kv ? "" : " MISMATCH");
+        printf("[KV %3luB] Value log: %lu bytes\n", (unsigned long)size, (unsigned long)log.Bytes());
+    }
 }
 
 void printUsage(const char* programName) {
-    std::cerr << "\nUsage: " << programName << " [Write Count] [Read Count] [Benchmark #]\n\n"
-              << "Benchmark can be selected by number or name.\n\n"
+    std::cerr << "\nUsage: " << programName << " [Write Count] [Read Count] [Benchmark #] [--inline-keys]\n\n"
+              << "Benchmark can be selected by number or name.\n"
+              << "Benchmarks 0-6 generate their keys before the timed loops and print the generator rate\n"
+              << "separately; --inline-keys generates them inside the timed loops instead.\n\n"
               << "Synthetic Benchmarks:\n"
               << " 0 - Sequential\n"
               << " 1 - Rev-Sequential\n"
@@ -227,11 +898,25 @@ void printUsage(const char* programName) {
               << " 3 - Zipfian\n"
               << " 4 - Uniform Delete\n"
               << " 5 - Zipfian Delete\n"
-              << " 6 - Scan\n";
+              << " 6 - Scan\n"
+              << " 7 - WAL Group Commit\n"
+              << " 8 - Range Delete\n"
+              << " 9 - Parallel Scan\n"
+              << "10 - Range Aggregate\n"
+              << "11 - Freeze (read-only layout)\n"
+              << "12 - Learned Index\n"
+              << "13 - Leaf Buffer\n"
+              << "14 - Hot Cache\n"
+              << "15 - Bloom Filter\n"
+              << "16 - Hybrid Index\n"
+              << "17 - String Keys\n"
+              << "18 - KV Upsert/Get\n";
 }
 
 int main(int argc, char *argv[]) {
-    if (argc != 4) {
+    if (argc == 5 && strcmp(argv[4], "--inline-keys") == 0) {
+        materialize_keys = false;
+    } else if (argc != 4) {
         printUsage(argv[0]);
         return 1;
     }
@@ -245,6 +930,10 @@ int main(int argc, char *argv[]) {
     auto runBenchmarkType1 = [&](const std::string& name, void (*benchmarkFunc)(int, int, Bplustree<Key>&)) {
         std::cout << "\n[" << name << " Benchmark in progress...]\n\n";
         benchmarkFunc(W, R, bpt);
+        if (generated_keys > 0) {
+            printf("[Key stream] %lu keys generated in %.2lf µs (%.2lf Mkeys/s), outside the timed loops\n",
+                   (unsigned long)generated_keys, generate_seconds * 1e6, generate_seconds > 0 ? generated_keys / generate_seconds * 1e-6 : 0.0);
+        }
     };
 
     switch (B) {
@@ -256,6 +945,18 @@ int main(int argc, char *argv[]) {
         case 4: runBenchmarkType1("Uniform Delete", Uniform_Delete); break;
         case 5: runBenchmarkType1("Zipfian Delete", Zipfian_Delete); break;
         case 6: runBenchmarkType1("Scan", Uniform_Scan); break;
+        case 7: runBenchmarkType1("WAL Group Commit", WAL_Commit); break;
+        case 8: runBenchmarkType1("Range Delete", Range_Delete); break;
+        case 9: runBenchmarkType1("Parallel Scan", Parallel_Scan); break;
+        case 10: runBenchmarkType1("Range Aggregate", Range_Aggregate); break;
+        case 11: runBenchmarkType1("Freeze", Freeze_Lookup); break;
+        case 12: runBenchmarkType1("Learned Index", Learned_Lookup); break;
+        case 13: runBenchmarkType1("Leaf Buffer", Leaf_Buffer); break;
+        case 14: runBenchmarkType1("Hot Cache", Hot_Cache); break;
+        case 15: runBenchmarkType1("Bloom Filter", Bloom_Filter); break;
+        case 16: runBenchmarkType1("Hybrid Index", Hybrid_Index); break;
+        case 17: runBenchmarkType1("String Keys", String_Keys); break;
+        case 18: runBenchmarkType1("KV Upsert/Get", KV_Store); break;
 
         default:
             std::cerr << "Invalid benchmark option provided.\n";
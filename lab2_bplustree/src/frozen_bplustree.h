@@ -0,0 +1,155 @@
+#ifndef FROZEN_BPLUSTREE_H
+#define FROZEN_BPLUSTREE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "leaf_kernels.h"
+
+// Immutable, pointer-free export of a Bplustree (CSS-tree layout).
+//
+// Every node is one 64-byte block of 8 keys. The leaf level is the sorted key array itself,
+// padded with the maximum key up to a whole block. Each upper level is an implicit array:
+// node i of a level has children i * 9 .. i * 9 + 8 on the level below, and its key j is the
+// largest key below child j. A lookup therefore only counts "keys < x" in one block per level
+// (branch-free, SIMD when available) and computes the next block index; no pointer is stored.
+template<typename Key>
+class FrozenBplustree {
+    static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value,
+                  "FrozenBplustree supports unsigned integer keys");
+
+   public:
+    static const int kBlockKeys = 64 / sizeof(Key); // Keys per cache line
+    static const int kFanout = kBlockKeys + 1;      // Children per internal block
+
+    // Builds the structure from keys in ascending order.
+    explicit FrozenBplustree(const std::vector<Key>& sorted_keys);
+
+    // Contains function: Returns true if the key exists.
+    bool Contains(const Key& key) const;
+
+    // LowerBound function: Returns the position of the first key >= 'key' (size() if there is none).
+    size_t LowerBound(const Key& key) const;
+
+    // Scan function: Returns up to 'scan_num' keys starting from the first key >= 'key'.
+    std::vector<Key> Scan(const Key& key, const int scan_num) const;
+
+    // Key at position 'pos' of the sorted key array
+    const Key& At(size_t pos) const { return leaves[pos / kBlockKeys].keys[pos % kBlockKeys]; }
+
+    size_t size() const { return count; }
+
+    // Bytes used by all levels
+    size_t MemoryBytes() const;
+
+   private:
+    struct alignas(64) Block {
+        Key keys[kBlockKeys];
+    };
+
+    // Number of keys in 'block' smaller than 'key'
+    static size_t Rank(const Block& block, const Key& key);
+
+    std::vector<Block> leaves;              // Sorted keys, padded to whole blocks
+    std::vector<std::vector<Block>> levels; // levels[0] is right above the leaves, levels.back() is the root
+    size_t count;                           // Number of real keys
+};
+
+template<typename Key>
+FrozenBplustree<Key>::FrozenBplustree(const std::vector<Key>& sorted_keys) : count(sorted_keys.size()) {
+    const Key pad = std::numeric_limits<Key>::max();
+
+    // 1. leaf level: 정렬된 key 배열을 block 단위로 채운다
+    size_t blocks = std::max<size_t>(1, (count + kBlockKeys - 1) / kBlockKeys);
+    leaves.resize(blocks);
+    for (size_t i = 0; i < blocks * kBlockKeys; i++) {
+        leaves[i / kBlockKeys].keys[i % kBlockKeys] = i < count ? sorted_keys[i] : pad;
+    }
+
+    // 각 block 아래의 최대 key (자식이 부모의 key가 된다)
+    std::vector<Key> maxes(blocks);
+    for (size_t i = 0; i < blocks; i++) {
+        maxes[i] = leaves[i].keys[kBlockKeys - 1];
+    }
+
+    // 2. block이 하나가 될 때까지 위 level을 만든다
+    while (maxes.size() > 1) {
+        size_t children = maxes.size();
+        size_t nodes = (children + kFanout - 1) / kFanout;
+        std::vector<Block> level(nodes);
+        std::vector<Key> next_maxes(nodes);
+        for (size_t i = 0; i < nodes; i++) {
+            size_t first = i * kFanout;
+            size_t last = std::min(children, first + kFanout); // exclusive
+            for (int j = 0; j < kBlockKeys; j++) {
+                size_t child = first + j;
+                // 마지막 자식은 경계가 없으므로 pad: "key < x" 개수가 존재하는 자식 수를 넘지 않는다
+                level[i].keys[j] = child + 1 < last ? maxes[child] : pad;
+            }
+            next_maxes[i] = maxes[last - 1];
+        }
+        levels.push_back(std::move(level));
+        maxes.swap(next_maxes);
+    }
+}
+
+template<typename Key>
+size_t FrozenBplustree<Key>::Rank(const Block& block, const Key& key) {
+    if constexpr (sizeof(Key) == 8) {
+        return RankBlock8((const uint64_t*)block.keys, key);
+    } else {
+        size_t rank = 0;
+        for (int i = 0; i < kBlockKeys; i++) {
+            rank += block.keys[i] < key;
+        }
+        return rank;
+    }
+}
+
+template<typename Key>
+size_t FrozenBplustree<Key>::LowerBound(const Key& key) const {
+    // root부터 block마다 "key보다 작은 key의 개수"로 자식 번호를 계산한다
+    size_t node = 0;
+    for (size_t l = levels.size(); l-- > 0;) {
+        node = node * kFanout + Rank(levels[l][node], key);
+    }
+    size_t pos = node * kBlockKeys + Rank(leaves[node], key);
+    return std::min(pos, count);
+}
+
+template<typename Key>
+bool FrozenBplustree<Key>::Contains(const Key& key) const {
+    size_t pos = LowerBound(key);
+    return pos < count && At(pos) == key;
+}
+
+template<typename Key>
+std::vector<Key> FrozenBplustree<Key>::Scan(const Key& key, const int scan_num) const {
+    std::vector<Key> result;
+    size_t pos = LowerBound(key);
+    size_t end = std::min(count, pos + (size_t)std::max(scan_num, 0));
+    result.reserve(end - pos);
+    for (; pos < end; pos++) {
+        // 연속된 배열이라 다음 cache line을 미리 가져온다
+        if (pos % kBlockKeys == 0) {
+            __builtin_prefetch(&leaves[pos / kBlockKeys] + 2);
+        }
+        result.push_back(At(pos));
+    }
+    return result;
+}
+
+template<typename Key>
+size_t FrozenBplustree<Key>::MemoryBytes() const {
+    size_t bytes = leaves.size() * sizeof(Block);
+    for (const auto& level : levels) {
+        bytes += level.size() * sizeof(Block);
+    }
+    return bytes;
+}
+
+#endif
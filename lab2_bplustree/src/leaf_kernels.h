@@ -0,0 +1,119 @@
+#ifndef LEAF_KERNELS_H
+#define LEAF_KERNELS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <immintrin.h>
+#include <emmintrin.h>
+
+// SIMD kernels that run directly over the sorted key array of a leaf.
+// The AVX2 versions are compiled with a target attribute and picked at run time,
+// so the rest of the build does not need -mavx2.
+
+// Sum of n keys, SSE2 (always available on x86-64)
+static inline uint64_t SumKeysSse2(const uint64_t* keys, size_t n) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_epi64(acc0, _mm_loadu_si128((const __m128i*)(keys + i)));
+        acc1 = _mm_add_epi64(acc1, _mm_loadu_si128((const __m128i*)(keys + i + 2)));
+    }
+    acc0 = _mm_add_epi64(acc0, acc1);
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc0);
+    uint64_t sum = lanes[0] + lanes[1];
+    for (; i < n; i++) {
+        sum += keys[i];
+    }
+    return sum;
+}
+
+// Sum of n keys, AVX2
+__attribute__((target("avx2")))
+static inline uint64_t SumKeysAvx2(const uint64_t* keys, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256((const __m256i*)(keys + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256((const __m256i*)(keys + i + 4)));
+    }
+    acc0 = _mm256_add_epi64(acc0, acc1);
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc0);
+    uint64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; i++) {
+        sum += keys[i];
+    }
+    return sum;
+}
+
+// Number of keys k with (k & mask) == value, AVX2
+__attribute__((target("avx2,popcnt")))
+static inline size_t CountKeysMaskedAvx2(const uint64_t* keys, size_t n, uint64_t mask, uint64_t value) {
+    const __m256i vmask = _mm256_set1_epi64x(mask);
+    const __m256i vvalue = _mm256_set1_epi64x(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i k = _mm256_loadu_si256((const __m256i*)(keys + i));
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_and_si256(k, vmask), vvalue);
+        count += _mm_popcnt_u32(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+    }
+    for (; i < n; i++) {
+        count += (keys[i] & mask) == value;
+    }
+    return count;
+}
+
+// Number of keys k with (k & mask) == value, scalar (branch-free)
+static inline size_t CountKeysMaskedScalar(const uint64_t* keys, size_t n, uint64_t mask, uint64_t value) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += (keys[i] & mask) == value;
+    }
+    return count;
+}
+
+// Number of keys in an 8-key block that are smaller than x (unsigned compare), AVX2
+__attribute__((target("avx2,popcnt")))
+static inline size_t RankBlock8Avx2(const uint64_t* block, uint64_t x) {
+    // cmpgt_epi64 is signed: flipping the sign bit turns it into an unsigned compare
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i vx = _mm256_xor_si256(_mm256_set1_epi64x((long long)x), sign);
+    __m256i a = _mm256_xor_si256(_mm256_load_si256((const __m256i*)block), sign);
+    __m256i b = _mm256_xor_si256(_mm256_load_si256((const __m256i*)(block + 4)), sign);
+    int lt_a = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vx, a)));
+    int lt_b = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vx, b)));
+    return _mm_popcnt_u32(lt_a | (lt_b << 4));
+}
+
+// Number of keys in an 8-key block that are smaller than x, scalar (branch-free)
+static inline size_t RankBlock8Scalar(const uint64_t* block, uint64_t x) {
+    size_t rank = 0;
+    for (int i = 0; i < 8; i++) {
+        rank += block[i] < x;
+    }
+    return rank;
+}
+
+static inline bool CpuHasAvx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    return avx2;
+}
+
+static inline uint64_t SumKeys(const uint64_t* keys, size_t n) {
+    return CpuHasAvx2() ? SumKeysAvx2(keys, n) : SumKeysSse2(keys, n);
+}
+
+static inline size_t CountKeysMasked(const uint64_t* keys, size_t n, uint64_t mask, uint64_t value) {
+    return CpuHasAvx2() ? CountKeysMaskedAvx2(keys, n, mask, value) : CountKeysMaskedScalar(keys, n, mask, value);
+}
+
+// 'block' must be 32-byte aligned
+static inline size_t RankBlock8(const uint64_t* block, uint64_t x) {
+    return CpuHasAvx2() ? RankBlock8Avx2(block, x) : RankBlock8Scalar(block, x);
+}
+
+#endif
@@ -0,0 +1,223 @@
+#ifndef LEARNED_INDEX_H
+#define LEARNED_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+// Error-bounded piecewise linear index over sorted, non-decreasing fence keys.
+//
+// Lookup(key) returns the value of the last fence <= key. The fences are cut into segments;
+// each segment keeps its own fence/value arrays and a line pos = slope * (key - anchor) fitted
+// with the shrinking-cone method so that every fence is predicted within 'epsilon' positions.
+// A lookup binary-searches the (small) segment directory, predicts a position and finishes with
+// a binary search of 2 * (epsilon + drift) + 3 entries around it.
+//
+// Insert() puts a new fence right after the entry of the value it was split from and only bumps that segment's 'drift' (positions
+// after the insert moved by one); the segment is re-fitted, together with a small right
+// neighbour, once the drift exceeds epsilon or the segment grows past kMaxSegment entries.
+template<typename Key, typename Value>
+class PiecewiseLinearIndex {
+    static_assert(std::is_arithmetic<Key>::value, "PiecewiseLinearIndex needs numeric keys");
+
+   public:
+    static const size_t kMaxSegment = 4096; // Bounds the cost of one Insert / Refit
+
+    explicit PiecewiseLinearIndex(size_t epsilon = 16) : epsilon(epsilon) {}
+
+    // Build function: Fits segments over 'fences' (sorted) and their 'values'.
+    void Build(const std::vector<Key>& fences, const std::vector<Value>& values);
+
+    // Lookup function: Returns the value of the last fence <= key (the first value if key is smaller than all).
+    Value Lookup(const Key& key) const;
+
+    // Insert function: Adds a new fence right after the entry whose value is 'after' and re-fits its segment
+    // when the error bound is used up. Fences may repeat (duplicate keys), so the key alone does not give the position.
+    void Insert(const Key& fence, const Value& value, const Value& after);
+
+    size_t SegmentCount() const { return segments.size(); }
+    size_t size() const;
+    size_t MemoryBytes() const;
+
+   private:
+    struct Segment {
+        Key anchor;                // Key predicted at position 0
+        double slope;              // Positions per key unit
+        size_t drift;              // Inserts since the last fit (extra error)
+        std::vector<Key> fences;   // Sorted fences of this segment
+        std::vector<Value> values; // Value of each fence
+    };
+
+    // (key - anchor) as a double without unsigned wrap-around
+    static double Distance(const Key& key, const Key& anchor) {
+        return key >= anchor ? (double)(key - anchor) : -(double)(anchor - key);
+    }
+
+    // Cuts [fences, values) into segments that respect epsilon and kMaxSegment, appending them to 'out'.
+    void Fit(const Key* fences, const Value* values, size_t n, std::vector<Segment>& out) const;
+
+    // Re-fits segment 's' (together with its successor when both fit in kMaxSegment) and
+    // replaces them by the resulting segments.
+    void Refit(size_t s);
+
+    // Index of the segment whose range contains 'key'
+    size_t FindSegment(const Key& key) const;
+
+    std::vector<Key> firsts;       // First fence of each segment (segment directory)
+    std::vector<Segment> segments;
+    size_t epsilon;
+};
+
+template<typename Key, typename Value>
+void PiecewiseLinearIndex<Key, Value>::Build(const std::vector<Key>& fences, const std::vector<Value>& values) {
+    segments.clear();
+    Fit(fences.data(), values.data(), fences.size(), segments);
+    firsts.clear();
+    for (const Segment& seg : segments) {
+        firsts.push_back(seg.fences.front());
+    }
+}
+
+template<typename Key, typename Value>
+void PiecewiseLinearIndex<Key, Value>::Fit(const Key* fences, const Value* values, size_t n,
+                                           std::vector<Segment>& out) const {
+    size_t i = 0;
+    while (i < n) {
+        // shrinking cone: anchor에서 뻗는 기울기의 허용 범위를 점마다 좁힌다
+        const Key anchor = fences[i];
+        double lo_slope = 0;
+        double hi_slope = std::numeric_limits<double>::infinity();
+        size_t j = i + 1;
+        for (; j < n && j - i < kMaxSegment; ++j) {
+            double dx = Distance(fences[j], anchor);
+            double dy = (double)(j - i);
+            if (dx <= 0) {
+                if (dy > epsilon) break; // 같은 fence가 epsilon개보다 많으면 끊는다
+                continue;
+            }
+            double lo = std::max(lo_slope, (dy - epsilon) / dx);
+            double hi = std::min(hi_slope, (dy + epsilon) / dx);
+            if (lo > hi) break;
+            lo_slope = lo;
+            hi_slope = hi;
+        }
+
+        Segment seg;
+        seg.anchor = anchor;
+        seg.slope = hi_slope == std::numeric_limits<double>::infinity() ? lo_slope : (lo_slope + hi_slope) / 2;
+        seg.drift = 0;
+        seg.fences.assign(fences + i, fences + j);
+        seg.values.assign(values + i, values + j);
+        out.push_back(std::move(seg));
+        i = j;
+    }
+}
+
+template<typename Key, typename Value>
+size_t PiecewiseLinearIndex<Key, Value>::FindSegment(const Key& key) const {
+    size_t s = std::upper_bound(firsts.begin(), firsts.end(), key) - firsts.begin();
+    return s > 0 ? s - 1 : 0;
+}
+
+template<typename Key, typename Value>
+Value PiecewiseLinearIndex<Key, Value>::Lookup(const Key& key) const {
+    const Segment& seg = segments[FindSegment(key)];
+    size_t n = seg.fences.size();
+
+    // 1. 모델로 위치를 예측한다
+    double p = seg.slope * Distance(key, seg.anchor);
+    size_t pos = p <= 0 ? 0 : std::min(n - 1, (size_t)p);
+
+    // 2. 오차 범위 안에서만 마지막 fence <= key 를 찾는다
+    size_t err = epsilon + seg.drift + 1;
+    size_t lo = pos > err ? pos - err : 0;
+    size_t hi = std::min(n, pos + err + 1);
+    size_t idx = std::upper_bound(seg.fences.begin() + lo, seg.fences.begin() + hi, key) - seg.fences.begin();
+    return seg.values[idx > 0 ? idx - 1 : 0];
+}
+
+template<typename Key, typename Value>
+void PiecewiseLinearIndex<Key, Value>::Insert(const Key& fence, const Value& value, const Value& after) {
+    if (segments.empty()) {
+        Build(std::vector<Key>{fence}, std::vector<Value>{value});
+        return;
+    }
+    // 1. 'after'의 항목은 fence <= 새 fence인 마지막 항목들 사이에 있다. 같은 fence가 여럿이면
+    //    segment 경계를 넘어 뒤에서부터 찾는다 (못 찾으면 같은 fence들의 뒤에 넣는다)
+    size_t s = FindSegment(fence);
+    size_t idx = std::upper_bound(segments[s].fences.begin(), segments[s].fences.end(), fence) - segments[s].fences.begin();
+    size_t t = s, i = idx;
+    while (true) {
+        const Segment& candidate = segments[t];
+        while (i > 0 && candidate.values[i - 1] != after && !(candidate.fences[i - 1] < fence)) {
+            i--;
+        }
+        if (i > 0 || t == 0) {
+            break;
+        }
+        t--;
+        i = segments[t].fences.size();
+    }
+    if (i > 0 && segments[t].values[i - 1] == after) {
+        s = t;
+        idx = i;
+    }
+    Segment& seg = segments[s];
+    seg.fences.insert(seg.fences.begin() + idx, fence);
+    seg.values.insert(seg.values.begin() + idx, value);
+    seg.drift++;
+    if (idx == 0) {
+        firsts[s] = fence;
+    }
+
+    // 오차 한도를 다 쓰거나 segment가 너무 커지면 이 segment만 다시 맞춘다
+    if (seg.drift > epsilon || seg.fences.size() > kMaxSegment) {
+        Refit(s);
+    }
+}
+
+template<typename Key, typename Value>
+void PiecewiseLinearIndex<Key, Value>::Refit(size_t s) {
+    // 1. 다음 segment가 작으면 함께 맞춘다 (Fit이 남기는 짧은 꼬리 segment가 쌓이지 않도록)
+    size_t count = 1;
+    std::vector<Key> fences = std::move(segments[s].fences);
+    std::vector<Value> values = std::move(segments[s].values);
+    if (s + 1 < segments.size() && fences.size() + segments[s + 1].fences.size() <= kMaxSegment) {
+        fences.insert(fences.end(), segments[s + 1].fences.begin(), segments[s + 1].fences.end());
+        values.insert(values.end(), segments[s + 1].values.begin(), segments[s + 1].values.end());
+        count = 2;
+    }
+
+    // 2. 다시 맞춘 segment들로 교체한다
+    std::vector<Segment> refit;
+    Fit(fences.data(), values.data(), fences.size(), refit);
+    segments.erase(segments.begin() + s, segments.begin() + s + count);
+    firsts.erase(firsts.begin() + s, firsts.begin() + s + count);
+    for (size_t i = 0; i < refit.size(); i++) {
+        firsts.insert(firsts.begin() + s + i, refit[i].fences.front());
+    }
+    segments.insert(segments.begin() + s, std::make_move_iterator(refit.begin()), std::make_move_iterator(refit.end()));
+}
+
+template<typename Key, typename Value>
+size_t PiecewiseLinearIndex<Key, Value>::size() const {
+    size_t count = 0;
+    for (const Segment& seg : segments) {
+        count += seg.fences.size();
+    }
+    return count;
+}
+
+template<typename Key, typename Value>
+size_t PiecewiseLinearIndex<Key, Value>::MemoryBytes() const {
+    size_t bytes = sizeof(*this) + firsts.capacity() * sizeof(Key) + segments.capacity() * sizeof(Segment);
+    for (const Segment& seg : segments) {
+        bytes += seg.fences.capacity() * sizeof(Key) + seg.values.capacity() * sizeof(Value);
+    }
+    return bytes;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+// Operation types stored in a log record
+enum WalOp : uint8_t {
+    WAL_INSERT = 1,
+    WAL_DELETE = 2,
+    WAL_DELETE_RANGE = 3, // key = lo, second key = hi
+};
+
+// Write-ahead log shared by SkipList and Bplustree.
+//
+// Record layout : crc32 (4 bytes) | op (1 byte) | key (varint, 1~10 bytes) [| hi (varint) for WAL_DELETE_RANGE]
+// The crc covers op and keys, so a torn record at the tail is detected on replay.
+//
+// Writers only append into an in-memory buffer. A single flusher thread writes
+// the buffer and calls fdatasync() once for every record gathered so far
+// (group commit). With commit_interval_us > 0 the flusher waits that long
+// before each sync so that more writers can join the same group.
+//
+// I/O errors are sticky: once opening, writing or syncing the log fails, no later record is
+// reported durable, and WaitDurable / Sync / Error return the errno of the first failure.
+class Wal {
+   public:
+    Wal(const char* path, long commit_interval_us = 0);
+    ~Wal();
+
+    // Append function:
+    // Queues a record and returns its log sequence number. Does not wait for disk.
+    // After an I/O error the record is dropped (WaitDurable on it returns the error).
+    uint64_t Append(WalOp op, uint64_t key, uint64_t hi = 0);
+
+    // WaitDurable function:
+    // Blocks until the record with the given sequence number has been synced and returns 0. Once the log
+    // has failed (open, write or sync) it returns that errno instead, even for records synced before.
+    int WaitDurable(uint64_t lsn);
+
+    // Sync function:
+    // Blocks until every record appended so far has been synced. Returns 0 or an errno as WaitDurable.
+    int Sync();
+
+    // errno of the first I/O error on the log (0 if none)
+    int Error();
+
+    // Number of fdatasync() calls issued (one per commit group)
+    uint64_t SyncCount();
+
+    // Replay function:
+    // Reads the log at 'path' and calls 'apply(op, key, hi)' for every valid record in order.
+    // Stops at the first corrupted or partial record. Returns the number of records applied.
+    static long Replay(const char* path, const std::function<void(WalOp, uint64_t, uint64_t)>& apply);
+
+   private:
+    void FlushLoop(); // Body of the flusher thread
+
+    int fd;                   // Log file descriptor, positioned at the end of the valid records
+    long commit_interval_us;  // Durability window of one commit group
+
+    std::mutex mu;
+    std::condition_variable work_cv;    // Signals the flusher that records are pending
+    std::condition_variable durable_cv; // Signals writers that durable_lsn moved
+    std::vector<char> pending;          // Encoded records not yet handed to the flusher
+    uint64_t next_lsn;                  // Sequence number of the next appended record
+    uint64_t durable_lsn;               // Every record up to this number is on disk
+    uint64_t sync_count;
+    int error;                          // Sticky errno of the first failed open/write/fdatasync (0 if none)
+    bool stop;
+    std::thread flusher;
+};
+
+#endif
@@ -1,3 +1,8 @@
+#ifndef ZIPF_H
+#define ZIPF_H
+
+#include <stdint.h>
+
 extern long items; //initialized in init_zipf_generator function
 //extern long base; //initialized in init_zipf_generator function
 extern double zipfianconstant; //initialized in init_zipf_generator function
@@ -15,3 +20,91 @@ double zetastatic(long st, long n, double initialsum);
 long nextLong(long itemcount);
 long nextValue();
 void setLastValue(long val);
+
+// zeta(n, theta) = sum_{i=1}^{n} i^-theta in O(kZetaExact) time (Euler-Maclaurin, see zipf.cc).
+// 'error_bound', if given, receives a bound on the absolute error of the result.
+static const uint64_t kZetaExact = 64;
+double ZetaSum(uint64_t n, double theta, double* error_bound = nullptr);
+
+// xoshiro256** (Blackman & Vigna): small, fast PRNG with 256 bits of state, seeded through splitmix64
+// so that any 64-bit seed gives a well-mixed state.
+class Xoshiro256 {
+   public:
+    explicit Xoshiro256(uint64_t seed = 1) { Seed(seed); }
+
+    void Seed(uint64_t seed) {
+        for (int i = 0; i < 4; i++) {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t Next() {
+        uint64_t result = Rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform double in [0, 1) from the top 53 bits
+    double NextDouble() { return (Next() >> 11) * 0x1.0p-53; }
+
+   private:
+    static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t s[4];
+};
+
+// Zipfian generator object: the algorithm of init_zipf_generator / nextLong (Gray et al., SIGMOD 1994)
+// with all of its state in the object and its own seeded PRNG instead of rand().
+//
+// Everything that depends only on (items, theta) is computed once in the constructor (zeta with
+// ZetaSum, so any range takes microseconds), and Next() is one PRNG draw, two compares and, beyond
+// the two hottest ranks, one power. When 1 / (1 - theta) is an integer (theta = 0.5, 0.75, 0.8, ...)
+// that power is a few multiplications instead of pow().
+//
+// An object is not shared between threads: give every thread its own copy and call Seed() on it
+// (copying does not recompute zeta). With 'scrambled' the rank is hashed over the range, as in YCSB's
+// ScrambledZipfian, so that the hot keys are spread across the key space instead of sitting at 'min'.
+class ZipfGenerator {
+   public:
+    ZipfGenerator(uint64_t min, uint64_t max, double theta = 0.8, uint64_t seed = 1, bool scrambled = false);
+
+    void Seed(uint64_t seed) { rng.Seed(seed); }
+
+    // Next function: Value in [min, max]; min is the most popular unless scrambled.
+    uint64_t Next();
+
+    // Grows the range to [min, min + items - 1] (zeta is extended term by term for a few new items,
+    // recomputed with ZetaSum otherwise).
+    void Resize(uint64_t items);
+
+    uint64_t Items() const { return items; }
+    double Theta() const { return theta; }
+
+   private:
+    uint64_t Rank(); // Unscrambled rank in [0, items)
+    double Power(double x) const;
+
+    uint64_t base;
+    uint64_t items;
+    double theta;
+    bool scrambled;
+
+    double zetan;      // zeta(items, theta)
+    double alpha;      // 1 / (1 - theta)
+    double eta;
+    double second;     // 1 + 0.5^theta: below it (times zetan) the rank is 1
+    int int_alpha;     // alpha as an integer, 0 if it is not one
+
+    Xoshiro256 rng;
+};
+
+#endif
@@ -7,8 +7,8 @@ sizes=(10000 1000000)
 for size in "${sizes[@]}"; do
     echo "Testing with read/write size: $size"
     
-    # Loop through options 0 to 6
-    for option in {0..6}; do
+    # Loop through options 0 to 18
+    for option in {0..18}; do
         echo "Running with option: $option"
         
         # Run the program with a timeout of 60 seconds
@@ -0,0 +1,629 @@
+#ifndef ART_H
+#define ART_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <type_traits>
+#include <emmintrin.h>
+
+// Adaptive Radix Tree (Leis et al., ICDE 2013) for unsigned integer keys.
+//
+// A key is split into bytes, most significant first, so the in-order walk of the tree is the key order.
+// Inner nodes grow and shrink between four layouts as their fan-out changes:
+//   Node4   : up to 4 sorted key bytes + children
+//   Node16  : up to 16 sorted key bytes, searched with one SSE2 compare
+//   Node48  : 256-entry byte -> slot index + 48 children
+//   Node256 : 256 children, indexed directly
+// Path compression stores the bytes shared by every key below a node in its prefix; with at most
+// 8 key bytes the whole prefix always fits in the node (no optimistic prefix check is needed).
+// Leaves are lazily expanded: a key hangs as a leaf directly below the first byte that tells it
+// apart from its neighbours. Leaf pointers are tagged with the low bit.
+//
+// Insert/Contains/Scan/Delete follow SkipList: duplicate inserts are ignored.
+template<typename Key>
+class Art {
+    static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value, "Art needs unsigned integer keys");
+
+   public:
+    Art();
+    ~Art();
+
+    void Insert(const Key& key);
+    bool Contains(const Key& key) const;
+    std::vector<Key> Scan(const Key& key, const int scan_num);
+    bool Delete(const Key& key);
+    void Print() const;
+
+    size_t size() const { return count; }
+    // Bytes allocated for inner nodes and leaves
+    size_t MemoryBytes() const { return memory; }
+
+   private:
+    static const int kKeyBytes = sizeof(Key);
+    static const int kMaxPrefix = sizeof(Key);
+
+    enum NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+    struct Node {
+        NodeType type;
+        uint8_t prefix_len;          // Number of valid bytes in 'prefix'
+        uint16_t num_children;
+        uint8_t prefix[kMaxPrefix];  // Compressed path shared by every key below this node
+    };
+    struct Node4 : Node {
+        uint8_t keys[4];
+        Node* children[4];
+    };
+    struct Node16 : Node {
+        uint8_t keys[16];
+        Node* children[16];
+    };
+    struct Node48 : Node {
+        uint8_t index[256]; // 0 = no child, otherwise slot + 1
+        Node* children[48];
+    };
+    struct Node256 : Node {
+        Node* children[256];
+    };
+    struct Leaf {
+        Key key;
+    };
+
+    // Byte 'depth' of the key, most significant byte first
+    static uint8_t Byte(const Key& key, int depth) { return (uint8_t)(key >> (8 * (kKeyBytes - 1 - depth))); }
+
+    static bool IsLeaf(const Node* node) { return (uintptr_t)node & 1; }
+    static Leaf* AsLeaf(const Node* node) { return (Leaf*)((uintptr_t)node & ~(uintptr_t)1); }
+    Node* MakeLeaf(const Key& key);
+
+    template<typename T>
+    T* NewNode(NodeType type);
+    void FreeNode(Node* node);
+    void FreeSubtree(Node* node);
+
+    // Number of prefix bytes of 'node' that match 'key' from 'depth'
+    static int PrefixMatch(const Node* node, const Key& key, int depth);
+
+    // Helper function to find the child slot for 'byte' (nullptr if there is none).
+    static Node** FindChild(Node* node, uint8_t byte);
+
+    // Helper function to add a child; grows the node (and updates 'ref') when it is full.
+    void AddChild(Node*& ref, uint8_t byte, Node* child);
+
+    // Helper function to remove the child for 'byte'; shrinks or collapses the node through 'ref'.
+    void RemoveChild(Node*& ref, uint8_t byte);
+
+    bool InsertInternal(Node*& ref, const Key& key, int depth);
+    bool DeleteInternal(Node*& ref, const Key& key, int depth);
+
+    // Helper function to append keys >= 'key' (only checked while 'bounded') in order until 'out' holds 'limit' keys.
+    void ScanInternal(const Node* node, const Key& key, int depth, bool bounded, std::vector<Key>& out, size_t limit) const;
+
+    void PrintRecursive(const Node* node, int level) const;
+
+    Node* root;    // nullptr for an empty tree, a tagged leaf for a single key
+    size_t count;  // Number of keys
+    size_t memory; // Bytes allocated for nodes and leaves
+};
+
+template<typename Key>
+Art<Key>::Art() : root(nullptr), count(0), memory(0) {
+}
+
+template<typename Key>
+Art<Key>::~Art() {
+    FreeSubtree(root);
+}
+
+template<typename Key>
+typename Art<Key>::Node* Art<Key>::MakeLeaf(const Key& key) {
+    Leaf* leaf = new Leaf{key};
+    memory += sizeof(Leaf);
+    return (Node*)((uintptr_t)leaf | 1);
+}
+
+template<typename Key>
+template<typename T>
+T* Art<Key>::NewNode(NodeType type) {
+    T* node = new T();
+    node->type = type;
+    memory += sizeof(T);
+    return node;
+}
+
+template<typename Key>
+void Art<Key>::FreeNode(Node* node) {
+    if (IsLeaf(node)) {
+        delete AsLeaf(node);
+        memory -= sizeof(Leaf);
+        return;
+    }
+    switch (node->type) {
+        case NODE4: delete static_cast<Node4*>(node); memory -= sizeof(Node4); break;
+        case NODE16: delete static_cast<Node16*>(node); memory -= sizeof(Node16); break;
+        case NODE48: delete static_cast<Node48*>(node); memory -= sizeof(Node48); break;
+        case NODE256: delete static_cast<Node256*>(node); memory -= sizeof(Node256); break;
+    }
+}
+
+template<typename Key>
+void Art<Key>::FreeSubtree(Node* node) {
+    if (!node) {
+        return;
+    }
+    if (!IsLeaf(node)) {
+        for (int b = 0; b < 256; b++) {
+            Node** child = FindChild(node, (uint8_t)b);
+            if (child) FreeSubtree(*child);
+        }
+    }
+    FreeNode(node);
+}
+
+template<typename Key>
+int Art<Key>::PrefixMatch(const Node* node, const Key& key, int depth) {
+    int i = 0;
+    while (i < node->prefix_len && node->prefix[i] == Byte(key, depth + i)) {
+        i++;
+    }
+    return i;
+}
+
+// FindChild function: Node16 compares all 16 key bytes at once.
+template<typename Key>
+typename Art<Key>::Node** Art<Key>::FindChild(Node* node, uint8_t byte) {
+    switch (node->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            for (int i = 0; i < n->num_children; i++) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+            __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((const __m128i*)n->keys));
+            unsigned mask = _mm_movemask_epi8(cmp) & ((1u << n->num_children) - 1);
+            return mask ? &n->children[__builtin_ctz(mask)] : nullptr;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            return n->index[byte] ? &n->children[n->index[byte] - 1] : nullptr;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            return n->children[byte] ? &n->children[byte] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+template<typename Key>
+void Art<Key>::AddChild(Node*& ref, uint8_t byte, Node* child) {
+    Node* node = ref;
+    switch (node->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            if (n->num_children < 4) {
+                // 정렬된 위치에 끼워 넣는다
+                int pos = 0;
+                while (pos < n->num_children && n->keys[pos] < byte) pos++;
+                memmove(n->keys + pos + 1, n->keys + pos, n->num_children - pos);
+                memmove(n->children + pos + 1, n->children + pos, (n->num_children - pos) * sizeof(Node*));
+                n->keys[pos] = byte;
+                n->children[pos] = child;
+                n->num_children++;
+                return;
+            }
+            // Node4 -> Node16
+            Node16* bigger = NewNode<Node16>(NODE16);
+            memcpy(bigger->prefix, n->prefix, n->prefix_len);
+            bigger->prefix_len = n->prefix_len;
+            memcpy(bigger->keys, n->keys, 4);
+            memcpy(bigger->children, n->children, 4 * sizeof(Node*));
+            bigger->num_children = 4;
+            FreeNode(n);
+            ref = bigger;
+            AddChild(ref, byte, child);
+            return;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+            if (n->num_children < 16) {
+                // byte보다 작은 key 수 = 삽입 위치 (부호 없는 비교를 위해 0x80을 뒤집는다)
+                const __m128i flip = _mm_set1_epi8((char)0x80);
+                __m128i keys = _mm_xor_si128(_mm_loadu_si128((const __m128i*)n->keys), flip);
+                __m128i less = _mm_cmplt_epi8(keys, _mm_xor_si128(_mm_set1_epi8((char)byte), flip));
+                unsigned mask = _mm_movemask_epi8(less) & ((1u << n->num_children) - 1);
+                int pos = __builtin_popcount(mask);
+                memmove(n->keys + pos + 1, n->keys + pos, n->num_children - pos);
+                memmove(n->children + pos + 1, n->children + pos, (n->num_children - pos) * sizeof(Node*));
+                n->keys[pos] = byte;
+                n->children[pos] = child;
+                n->num_children++;
+                return;
+            }
+            // Node16 -> Node48
+            Node48* bigger = NewNode<Node48>(NODE48);
+            memcpy(bigger->prefix, n->prefix, n->prefix_len);
+            bigger->prefix_len = n->prefix_len;
+            for (int i = 0; i < 16; i++) {
+                bigger->children[i] = n->children[i];
+                bigger->index[n->keys[i]] = i + 1;
+            }
+            bigger->num_children = 16;
+            FreeNode(n);
+            ref = bigger;
+            AddChild(ref, byte, child);
+            return;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            if (n->num_children < 48) {
+                int slot = 0;
+                while (n->children[slot]) slot++; // 삭제로 생긴 빈 칸도 다시 쓴다
+                n->children[slot] = child;
+                n->index[byte] = slot + 1;
+                n->num_children++;
+                return;
+            }
+            // Node48 -> Node256
+            Node256* bigger = NewNode<Node256>(NODE256);
+            memcpy(bigger->prefix, n->prefix, n->prefix_len);
+            bigger->prefix_len = n->prefix_len;
+            for (int b = 0; b < 256; b++) {
+                if (n->index[b]) bigger->children[b] = n->children[n->index[b] - 1];
+            }
+            bigger->num_children = 48;
+            FreeNode(n);
+            ref = bigger;
+            AddChild(ref, byte, child);
+            return;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = child;
+            n->num_children++;
+            return;
+        }
+    }
+}
+
+template<typename Key>
+void Art<Key>::RemoveChild(Node*& ref, uint8_t byte) {
+    Node* node = ref;
+    switch (node->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            int pos = 0;
+            while (n->keys[pos] != byte) pos++;
+            memmove(n->keys + pos, n->keys + pos + 1, n->num_children - pos - 1);
+            memmove(n->children + pos, n->children + pos + 1, (n->num_children - pos - 1) * sizeof(Node*));
+            n->num_children--;
+            if (n->num_children > 1) {
+                return;
+            }
+            // 자식이 하나 남으면 이 노드를 없애고 prefix를 자식에게 붙인다 (path compression)
+            Node* child = n->children[0];
+            if (!IsLeaf(child)) {
+                uint8_t prefix[kMaxPrefix];
+                int len = 0;
+                memcpy(prefix, n->prefix, n->prefix_len);
+                len = n->prefix_len;
+                prefix[len++] = n->keys[0];
+                memcpy(prefix + len, child->prefix, child->prefix_len);
+                len += child->prefix_len;
+                memcpy(child->prefix, prefix, len);
+                child->prefix_len = len;
+            }
+            FreeNode(n);
+            ref = child;
+            return;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+            int pos = __builtin_ctz(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((const __m128i*)n->keys))) &
+                ((1u << n->num_children) - 1));
+            memmove(n->keys + pos, n->keys + pos + 1, n->num_children - pos - 1);
+            memmove(n->children + pos, n->children + pos + 1, (n->num_children - pos - 1) * sizeof(Node*));
+            n->num_children--;
+            if (n->num_children > 3) {
+                return;
+            }
+            // Node16 -> Node4
+            Node4* smaller = NewNode<Node4>(NODE4);
+            memcpy(smaller->prefix, n->prefix, n->prefix_len);
+            smaller->prefix_len = n->prefix_len;
+            memcpy(smaller->keys, n->keys, n->num_children);
+            memcpy(smaller->children, n->children, n->num_children * sizeof(Node*));
+            smaller->num_children = n->num_children;
+            FreeNode(n);
+            ref = smaller;
+            return;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            n->children[n->index[byte] - 1] = nullptr;
+            n->index[byte] = 0;
+            n->num_children--;
+            if (n->num_children > 12) {
+                return;
+            }
+            // Node48 -> Node16 (byte 순서대로 옮기면 정렬이 유지된다)
+            Node16* smaller = NewNode<Node16>(NODE16);
+            memcpy(smaller->prefix, n->prefix, n->prefix_len);
+            smaller->prefix_len = n->prefix_len;
+            int pos = 0;
+            for (int b = 0; b < 256; b++) {
+                if (n->index[b]) {
+                    smaller->keys[pos] = (uint8_t)b;
+                    smaller->children[pos++] = n->children[n->index[b] - 1];
+                }
+            }
+            smaller->num_children = pos;
+            FreeNode(n);
+            ref = smaller;
+            return;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = nullptr;
+            n->num_children--;
+            if (n->num_children > 37) {
+                return;
+            }
+            // Node256 -> Node48
+            Node48* smaller = NewNode<Node48>(NODE48);
+            memcpy(smaller->prefix, n->prefix, n->prefix_len);
+            smaller->prefix_len = n->prefix_len;
+            int slot = 0;
+            for (int b = 0; b < 256; b++) {
+                if (n->children[b]) {
+                    smaller->children[slot] = n->children[b];
+                    smaller->index[b] = ++slot;
+                }
+            }
+            smaller->num_children = slot;
+            FreeNode(n);
+            ref = smaller;
+            return;
+        }
+    }
+}
+
+// Insert function (inserts a key into the tree)
+template<typename Key>
+void Art<Key>::Insert(const Key& key) {
+    if (InsertInternal(root, key, 0)) {
+        count++;
+    }
+}
+
+template<typename Key>
+bool Art<Key>::InsertInternal(Node*& ref, const Key& key, int depth) {
+    // 1. 빈 자리면 leaf를 바로 매단다
+    if (!ref) {
+        ref = MakeLeaf(key);
+        return true;
+    }
+
+    // 2. leaf를 만나면 두 key가 갈라지는 byte까지를 prefix로 갖는 Node4로 바꾼다
+    if (IsLeaf(ref)) {
+        Key existing = AsLeaf(ref)->key;
+        if (existing == key) {
+            return false;
+        }
+        int split = depth;
+        while (Byte(existing, split) == Byte(key, split)) {
+            split++;
+        }
+        Node4* node = NewNode<Node4>(NODE4);
+        node->prefix_len = split - depth;
+        for (int i = depth; i < split; i++) {
+            node->prefix[i - depth] = Byte(key, i);
+        }
+        Node* parent = node;
+        AddChild(parent, Byte(existing, split), ref);
+        AddChild(parent, Byte(key, split), MakeLeaf(key));
+        ref = parent;
+        return true;
+    }
+
+    // 3. prefix 중간에서 갈라지면 갈라지는 지점에 새 Node4를 끼운다
+    Node* node = ref;
+    int matched = PrefixMatch(node, key, depth);
+    if (matched < node->prefix_len) {
+        Node4* upper = NewNode<Node4>(NODE4);
+        upper->prefix_len = matched;
+        memcpy(upper->prefix, node->prefix, matched);
+        uint8_t node_byte = node->prefix[matched];
+        node->prefix_len -= matched + 1;
+        memmove(node->prefix, node->prefix + matched + 1, node->prefix_len);
+        Node* parent = upper;
+        AddChild(parent, node_byte, node);
+        AddChild(parent, Byte(key, depth + matched), MakeLeaf(key));
+        ref = parent;
+        return true;
+    }
+    depth += node->prefix_len;
+
+    // 4. 자식으로 내려가거나, 없으면 이 노드에 leaf를 추가한다
+    Node** child = FindChild(node, Byte(key, depth));
+    if (child) {
+        return InsertInternal(*child, key, depth + 1);
+    }
+    AddChild(ref, Byte(key, depth), MakeLeaf(key));
+    return true;
+}
+
+// Lookup function (checks if a key exists in the tree)
+template<typename Key>
+bool Art<Key>::Contains(const Key& key) const {
+    Node* node = root;
+    int depth = 0;
+    while (node) {
+        if (IsLeaf(node)) {
+            return AsLeaf(node)->key == key;
+        }
+        if (PrefixMatch(node, key, depth) < node->prefix_len) {
+            return false;
+        }
+        depth += node->prefix_len;
+        Node** child = FindChild(node, Byte(key, depth));
+        if (!child) {
+            return false;
+        }
+        node = *child;
+        depth++;
+    }
+    return false;
+}
+
+// Delete function (removes a key from the tree)
+template<typename Key>
+bool Art<Key>::Delete(const Key& key) {
+    if (DeleteInternal(root, key, 0)) {
+        count--;
+        return true;
+    }
+    return false;
+}
+
+template<typename Key>
+bool Art<Key>::DeleteInternal(Node*& ref, const Key& key, int depth) {
+    if (!ref) {
+        return false;
+    }
+    if (IsLeaf(ref)) {
+        // root 자체가 leaf인 경우
+        if (AsLeaf(ref)->key != key) {
+            return false;
+        }
+        FreeNode(ref);
+        ref = nullptr;
+        return true;
+    }
+
+    Node* node = ref;
+    if (PrefixMatch(node, key, depth) < node->prefix_len) {
+        return false;
+    }
+    depth += node->prefix_len;
+    uint8_t byte = Byte(key, depth);
+    Node** child = FindChild(node, byte);
+    if (!child) {
+        return false;
+    }
+    if (IsLeaf(*child)) {
+        if (AsLeaf(*child)->key != key) {
+            return false;
+        }
+        // leaf를 지우고 노드를 줄이거나 합친다
+        FreeNode(*child);
+        RemoveChild(ref, byte);
+        return true;
+    }
+    return DeleteInternal(*child, key, depth + 1);
+}
+
+// Range query function (retrieves scan_num keys starting from key)
+template<typename Key>
+std::vector<Key> Art<Key>::Scan(const Key& key, const int scan_num) {
+    std::vector<Key> result;
+    if (scan_num > 0) {
+        ScanInternal(root, key, 0, true, result, scan_num);
+    }
+    return result;
+}
+
+template<typename Key>
+void Art<Key>::ScanInternal(const Node* node, const Key& key, int depth, bool bounded,
+                            std::vector<Key>& out, size_t limit) const {
+    if (!node || out.size() >= limit) {
+        return;
+    }
+    if (IsLeaf(node)) {
+        Key leaf_key = AsLeaf(node)->key;
+        if (!bounded || leaf_key >= key) {
+            out.push_back(leaf_key);
+        }
+        return;
+    }
+
+    // 1. 아직 key와 같은 경로 위에 있다면 prefix를 비교한다
+    if (bounded) {
+        for (int i = 0; i < node->prefix_len; i++) {
+            uint8_t b = Byte(key, depth + i);
+            if (node->prefix[i] < b) {
+                return; // 이 subtree는 전부 key보다 작다
+            }
+            if (node->prefix[i] > b) {
+                bounded = false; // 이 subtree는 전부 key보다 크다
+                break;
+            }
+        }
+    }
+    depth += node->prefix_len;
+    uint8_t from = bounded ? Byte(key, depth) : 0;
+
+    // 2. 자식들을 byte 순서대로 방문한다. key와 같은 byte의 자식만 계속 경계를 확인한다
+    auto visit = [&](uint8_t b, const Node* child) {
+        ScanInternal(child, key, depth + 1, bounded && b == from, out, limit);
+    };
+    switch (node->type) {
+        case NODE4:
+        case NODE16: {
+            const uint8_t* keys = node->type == NODE4 ? static_cast<const Node4*>(node)->keys
+                                                      : static_cast<const Node16*>(node)->keys;
+            Node* const* children = node->type == NODE4 ? static_cast<const Node4*>(node)->children
+                                                        : static_cast<const Node16*>(node)->children;
+            for (int i = 0; i < node->num_children && out.size() < limit; i++) {
+                if (keys[i] >= from) visit(keys[i], children[i]);
+            }
+            break;
+        }
+        case NODE48: {
+            const Node48* n = static_cast<const Node48*>(node);
+            for (int b = from; b < 256 && out.size() < limit; b++) {
+                if (n->index[b]) visit((uint8_t)b, n->children[n->index[b] - 1]);
+            }
+            break;
+        }
+        case NODE256: {
+            const Node256* n = static_cast<const Node256*>(node);
+            for (int b = from; b < 256 && out.size() < limit; b++) {
+                if (n->children[b]) visit((uint8_t)b, n->children[b]);
+            }
+            break;
+        }
+    }
+}
+
+template<typename Key>
+void Art<Key>::Print() const {
+    PrintRecursive(root, 0);
+}
+
+template<typename Key>
+void Art<Key>::PrintRecursive(const Node* node, int level) const {
+    if (!node) return;
+    for (int i = 0; i < level; ++i)
+        std::cout << "  ";
+    if (IsLeaf(node)) {
+        std::cout << "[Leaf] " << AsLeaf(node)->key << std::endl;
+        return;
+    }
+    static const char* names[] = {"Node4", "Node16", "Node48", "Node256"};
+    std::cout << "[" << names[node->type] << "] prefix " << (int)node->prefix_len << " bytes, "
+              << node->num_children << " children" << std::endl;
+    for (int b = 0; b < 256; b++) {
+        Node** child = FindChild(const_cast<Node*>(node), (uint8_t)b);
+        if (child) PrintRecursive(*child, level + 1);
+    }
+}
+
+#endif
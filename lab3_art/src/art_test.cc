@@ -0,0 +1,184 @@
+#include <iostream>
+#include <set>
+#include <random>
+#include <assert.h>
+
+#include <chrono>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include <climits>
+#include <malloc.h>
+
+#include "zipf.h"
+#include "latest-generator.h"
+#include "skiplist.h"
+#include "bplustree.h"
+#include "art.h"
+#include "key_stream.h"
+
+// The workloads of lab1/lab2, written once for any index with Insert/Contains/Scan/Delete.
+// By default the keys of every timed loop are generated into a KeyStream first (key_stream.h), so the
+// times are index time only; --inline-keys generates them inside the timed loops as before.
+static bool materialize_keys = true;
+static double generate_seconds = 0; // Generator time of the current run (outside the timed loops)
+
+// timedLoop function: Calls op(next(i)) for i in [0, n) and returns the time of the loop in µs.
+template<typename Next, typename Op>
+float timedLoop(const int n, Next next, Op op) {
+    if (!materialize_keys) {
+        auto start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            op((Key)next(i));
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 0.001;
+    }
+    KeyStream keys(n < 0 ? 0 : n, next);
+    generate_seconds += keys.GenerateSeconds();
+    auto start = Clock::now();
+    for (size_t i = 0; i < keys.Size(); i++) {
+        op((Key)keys[i]);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() * 0.001;
+}
+
+template<typename Index>
+void Zipfian(const int write, const int read, Index& idx) {
+    // Zipfian distribution generator
+    init_zipf_generator(0, write);
+
+    // Insert, then search for keys following Zipfian distribution
+    float w_time = timedLoop(write, [&](int) { return nextValue() % write + 1; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [&](int) { return nextValue() % read + 1; }, [&](Key key) { idx.Contains(key); });
+    printf("Insertion = %12.2lf µs, Lookup = %12.2lf µs", w_time, r_time);
+}
+
+template<typename Index>
+void Uniform(const int write, const int read, Index& idx) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> distr(1, write);
+
+    float w_time = timedLoop(write, [&](int) { return distr(gen) + 1; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [&](int) { return distr(gen) + 1; }, [&](Key key) { idx.Contains(key); });
+    printf("Insertion = %12.2lf µs, Lookup = %12.2lf µs", w_time, r_time);
+}
+
+template<typename Index>
+void RevSequential(const int write, const int read, Index& idx) {
+    float w_time = timedLoop(write, [&](int i) { return write - i; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [&](int i) { return read - i; }, [&](Key key) { idx.Contains(key); });
+    printf("Insertion = %12.2lf µs, Lookup = %12.2lf µs", w_time, r_time);
+}
+
+template<typename Index>
+void Sequential(const int write, const int read, Index& idx) {
+    float w_time = timedLoop(write, [](int i) { return i + 1; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [](int i) { return i + 1; }, [&](Key key) { idx.Contains(key); });
+    printf("Insertion = %12.2lf µs, Lookup = %12.2lf µs", w_time, r_time);
+}
+
+template<typename Index>
+void Zipfian_Delete(const int write, const int read, Index& idx) {
+    init_zipf_generator(0, write);
+
+    float w_time = timedLoop(write, [&](int) { return nextValue() % write + 1; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [&](int) { return nextValue() % read + 1; }, [&](Key key) { idx.Delete(key); });
+    printf("Insertion = %12.2lf µs, Deletion = %12.2lf µs", w_time, r_time);
+}
+
+template<typename Index>
+void Uniform_Delete(const int write, const int read, Index& idx) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> distr(1, write);
+
+    float w_time = timedLoop(write, [&](int) { return distr(gen) + 1; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [&](int) { return distr(gen) + 1; }, [&](Key key) { idx.Delete(key); });
+    printf("Insertion = %12.2lf µs, Deletion = %12.2lf µs", w_time, r_time);
+}
+
+template<typename Index>
+void Uniform_Scan(const int write, const int read, Index& idx) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> distr(0, write);
+
+    float w_time = timedLoop(write, [](int i) { return i + 1; }, [&](Key key) { idx.Insert(key); });
+    float r_time = timedLoop(read, [&](int) { return distr(gen) + 1; }, [&](Key key) { idx.Scan(key, 1000); });
+    printf("Insertion = %12.2lf µs, Scan   = %12.2lf µs", w_time, r_time);
+}
+
+// Runs one workload on a fresh index and reports its heap footprint (live malloc bytes) per key.
+// The same seeds are used for every structure, so they all hold the same keys.
+template<typename Index>
+void runOn(const char* name, void (*benchmarkFunc)(int, int, Index&), int write, int read) {
+    size_t heap_before = mallinfo2().uordblks;
+    Index* idx = new Index();
+    srand(1);
+    generate_seconds = 0;
+
+    printf("[%-9s] ", name);
+    benchmarkFunc(write, read, *idx);
+    if (materialize_keys) {
+        printf(", Keys = %10.2lf µs", generate_seconds * 1e6);
+    }
+
+    size_t heap = mallinfo2().uordblks - heap_before;
+    size_t keys = idx->Scan(0, INT_MAX).size();
+    printf(", Memory = %10lu bytes (%.2lf bytes/key)\n", (unsigned long)heap, keys ? (double)heap / keys : 0.0);
+    delete idx;
+}
+
+void printUsage(const char* programName) {
+    std::cerr << "\nUsage: " << programName << " [Write Count] [Read Count] [Benchmark #] [--inline-keys]\n\n"
+              << "Every benchmark runs on Art, SkipList and Bplustree.\n"
+              << "Keys are generated before the timed loops (Keys = generator time, not included in the other times);\n"
+              << "--inline-keys generates them inside the timed loops instead.\n\n"
+              << "Synthetic Benchmarks:\n"
+              << " 0 - Sequential\n"
+              << " 1 - Rev-Sequential\n"
+              << " 2 - Uniform\n"
+              << " 3 - Zipfian\n"
+              << " 4 - Uniform Delete\n"
+              << " 5 - Zipfian Delete\n"
+              << " 6 - Scan\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 5 && strcmp(argv[4], "--inline-keys") == 0) {
+        materialize_keys = false;
+    } else if (argc != 4) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const int W = std::atoi(argv[1]);  // Insertion count
+    const int R = std::atoi(argv[2]);  // Lookup count
+    const int B = std::atoi(argv[3]);  // Benchmark type
+
+#define RUN_ALL(name, func)                                                \
+    do {                                                                   \
+        std::cout << "\n[" << name << " Benchmark in progress...]\n\n";   \
+        runOn<Art<Key>>("Art", func, W, R);                                \
+        runOn<SkipList<Key>>("SkipList", func, W, R);                      \
+        runOn<Bplustree<Key>>("Bplustree", func, W, R);                    \
+    } while (0)
+
+    switch (B) {
+        case 0: RUN_ALL("Sequential", Sequential); break;
+        case 1: RUN_ALL("Rev-Sequential", RevSequential); break;
+        case 2: RUN_ALL("Uniform", Uniform); break;
+        case 3: RUN_ALL("Zipfian", Zipfian); break;
+        case 4: RUN_ALL("Uniform Delete", Uniform_Delete); break;
+        case 5: RUN_ALL("Zipfian Delete", Zipfian_Delete); break;
+        case 6: RUN_ALL("Scan", Uniform_Scan); break;
+
+        default:
+            std::cerr << "Invalid benchmark option provided.\n";
+            printUsage(argv[0]);
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+#include <chrono>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+
+#include "zipf.h"
+#include "latest-generator.h"
+#include "skiplist.h"
+#include "bplustree.h"
+#include "lsm_index.h"
+#include "sharded_index.h"
+
+// The LSM workloads run on the composite index and on a plain Bplustree of the same degree.
+// The keys are distinct (a shuffled 1..write), so both hold exactly the same set and must report the same hits.
+
+static const int kDegree = 64;
+
+struct TreeIndex : public Bplustree<Key> {
+    TreeIndex() : Bplustree<Key>(kDegree) {}
+};
+
+// Extra counters printed after the timings
+void printStats(LsmIndex<Key>& idx) { printf(", Merges = %lu, Stalls = %lu", (unsigned long)idx.Merges(), (unsigned long)idx.Stalls()); }
+void printStats(TreeIndex&) {}
+
+std::vector<Key> shuffledKeys(const int write) {
+    std::vector<Key> keys(write);
+    for (int i = 0; i < write; i++) {
+        keys[i] = i + 1;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+    return keys;
+}
+
+template<typename Index>
+void Sequential(const int write, const int read, Index& idx) {
+    auto w_start = Clock::now();
+    for (int i = 1; i <= write; ++i) {
+        idx.Insert(i);
+    }
+    auto w_end = Clock::now();
+
+    int hits = 0;
+    auto r_start = Clock::now();
+    for (int i = 1; i <= read; ++i) {
+        hits += idx.Contains(i);
+    }
+    auto r_end = Clock::now();
+
+    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("Insertion = %12.2lf µs, Lookup = %12.2lf µs, Hits = %d", w_time, r_time, hits);
+}
+
+template<typename Index>
+void Uniform(const int write, const int read, Index& idx) {
+    std::vector<Key> keys = shuffledKeys(write);
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> distr(1, 2 * write); // 절반은 없는 key
+
+    auto w_start = Clock::now();
+    for (Key key : keys) {
+        idx.Insert(key);
+    }
+    auto w_end = Clock::now();
+
+    int hits = 0;
+    auto r_start = Clock::now();
+    for (int i = 1; i <= read; ++i) {
+        hits += idx.Contains(distr(gen));
+    }
+    auto r_end = Clock::now();
+
+    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("Insertion = %12.2lf µs, Lookup = %12.2lf µs, Hits = %d", w_time, r_time, hits);
+}
+
+template<typename Index>
+void Uniform_Delete(const int write, const int read, Index& idx) {
+    std::vector<Key> keys = shuffledKeys(write);
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> distr(1, write);
+
+    // 1. 모두 삽입한 뒤 임의의 절반을 삭제하는 시간까지 쓰기로 잰다
+    auto w_start = Clock::now();
+    for (Key key : keys) {
+        idx.Insert(key);
+    }
+    for (int i = 0; i < write / 2; i++) {
+        idx.Delete(keys[i]);
+    }
+    auto w_end = Clock::now();
+
+    int hits = 0;
+    auto r_start = Clock::now();
+    for (int i = 1; i <= read; ++i) {
+        hits += idx.Contains(distr(gen));
+    }
+    auto r_end = Clock::now();
+
+    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("Write     = %12.2lf µs, Lookup = %12.2lf µs, Hits = %d", w_time, r_time, hits);
+}
+
+template<typename Index>
+void Uniform_Scan(const int write, const int read, Index& idx) {
+    std::vector<Key> keys = shuffledKeys(write);
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> distr(1, write);
+
+    auto w_start = Clock::now();
+    for (Key key : keys) {
+        idx.Insert(key);
+    }
+    for (int i = 0; i < write / 4; i++) {
+        idx.Delete(keys[i]);
+    }
+    auto w_end = Clock::now();
+
+    size_t scanned = 0;
+    auto r_start = Clock::now();
+    for (int i = 1; i <= read; ++i) {
+        scanned += idx.Scan(distr(gen), 100).size();
+    }
+    auto r_end = Clock::now();
+
+    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("Write     = %12.2lf µs, Scan   = %12.2lf µs, Keys = %lu", w_time, r_time, (unsigned long)scanned);
+}
+
+template<typename Index>
+void runOn(const char* name, void (*benchmarkFunc)(int, int, Index&), int write, int read) {
+    Index* idx = new Index();
+    printf("[%-9s] ", name);
+    benchmarkFunc(write, read, *idx);
+    printStats(*idx);
+    printf("\n");
+    delete idx;
+}
+
+// Sharded workloads: the keys are generated up front (so generating them is not timed) and
+// split between as many client threads as there are shards. Inserts are queued, so the insertion time
+// includes Drain(); lookups / scans wait for their shard.
+void shardedRun(int shards, size_t rebalance_interval, const std::vector<Key>& writes, const std::vector<Key>& reads, bool scan) {
+    ShardedIndex<Key, TreeIndex> idx(shards, writes.size(), rebalance_interval);
+
+    auto w_start = Clock::now();
+    std::vector<std::thread> clients;
+    for (int t = 0; t < shards; t++) {
+        clients.emplace_back([&, t] {
+            for (size_t i = t; i < writes.size(); i += shards) {
+                idx.Insert(writes[i]);
+            }
+        });
+    }
+    for (auto& client : clients) client.join();
+    idx.Drain();
+    auto w_end = Clock::now();
+
+    std::atomic<size_t> hits(0);
+    clients.clear();
+    auto r_start = Clock::now();
+    for (int t = 0; t < shards; t++) {
+        clients.emplace_back([&, t] {
+            size_t found = 0;
+            for (size_t i = t; i < reads.size(); i += shards) {
+                found += scan ? idx.Scan(reads[i], 100).size() : idx.Contains(reads[i]);
+            }
+            hits += found;
+        });
+    }
+    for (auto& client : clients) client.join();
+    auto r_end = Clock::now();
+
+    float w_time = std::chrono::duration_cast<std::chrono::nanoseconds>(w_end - w_start).count() * 0.001;
+    float r_time = std::chrono::duration_cast<std::chrono::nanoseconds>(r_end - r_start).count() * 0.001;
+    printf("[%d shard%s] Insertion = %12.2lf µs (%6.2lf Mops/s), %s = %12.2lf µs (%6.2lf Mops/s), %s = %lu, Rebalances = %lu, Moved = %lu\n",
+           shards, shards > 1 ? "s" : " ", w_time, writes.size() / w_time, scan ? "Scan  " : "Lookup", r_time, reads.size() / r_time,
+           scan ? "Keys" : "Hits", (unsigned long)hits.load(), (unsigned long)idx.Rebalances(), (unsigned long)idx.MovedKeys());
+}
+
+void Sharded_Uniform(const int write, const int read) {
+    std::vector<Key> writes = shuffledKeys(write);
+    std::vector<Key> reads(read);
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> distr(1, 2 * write);
+    for (Key& key : reads) key = distr(gen);
+    for (int shards = 1; shards <= 8; shards *= 2) {
+        shardedRun(shards, 0, writes, reads, false);
+    }
+}
+
+void Sharded_Zipfian(const int write, const int read) {
+    // zipf의 인기 key는 작은 값에 몰려 있으므로 첫 shard로 부하가 쏠린다
+    ZipfGenerator zipf(0, write, 0.8, 1);
+    std::vector<Key> writes(write);
+    std::vector<Key> reads(read);
+    for (Key& key : writes) key = zipf.Next() % write + 1;
+    for (Key& key : reads) key = zipf.Next() % write + 1;
+    for (int shards = 1; shards <= 8; shards *= 2) {
+        printf("No rebalance   ");
+        shardedRun(shards, 0, writes, reads, false);
+        printf("With rebalance ");
+        shardedRun(shards, std::max(write / 8, 1), writes, reads, false);
+    }
+}
+
+void Sharded_Scan(const int write, const int read) {
+    std::vector<Key> writes = shuffledKeys(write);
+    std::vector<Key> reads(read);
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> distr(1, write);
+    for (Key& key : reads) key = distr(gen);
+    for (int shards = 1; shards <= 8; shards *= 2) {
+        shardedRun(shards, 0, writes, reads, true);
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cerr << "\nUsage: " << programName << " [Write Count] [Read Count] [Benchmark #]\n\n"
+              << "The LSM benchmarks run on the composite index and on a Bplustree of degree " << kDegree << ",\n"
+              << "the sharded ones use a Bplustree of that degree in every shard.\n\n"
+              << "LSM (SkipList memtable + Bplustree) Benchmarks:\n"
+              << " 0 - LSM Sequential\n"
+              << " 1 - LSM Uniform\n"
+              << " 2 - LSM Uniform Delete\n"
+              << " 3 - LSM Scan\n\n"
+              << "Range-Sharded Index Benchmarks (1, 2, 4 and 8 shards, one client thread per shard):\n"
+              << " 4 - Sharded Uniform\n"
+              << " 5 - Sharded Zipfian (with and without rebalancing)\n"
+              << " 6 - Sharded Scan\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 4) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const int W = std::atoi(argv[1]);  // Insertion count
+    const int R = std::atoi(argv[2]);  // Lookup count
+    const int B = std::atoi(argv[3]);  // Benchmark type
+
+    srand(1);
+
+#define RUN_LSM(name, func)                                                \
+    do {                                                                   \
+        std::cout << "\n[" << name << " Benchmark in progress...]\n\n";   \
+        runOn<LsmIndex<Key>>("LsmIndex", func, W, R);                      \
+        runOn<TreeIndex>("Bplustree", func, W, R);                         \
+    } while (0)
+
+    switch (B) {
+        case 0: RUN_LSM("LSM Sequential", Sequential); break;
+        case 1: RUN_LSM("LSM Uniform", Uniform); break;
+        case 2: RUN_LSM("LSM Uniform Delete", Uniform_Delete); break;
+        case 3: RUN_LSM("LSM Scan", Uniform_Scan); break;
+        case 4: std::cout << "\n[Sharded Uniform Benchmark in progress...]\n\n"; Sharded_Uniform(W, R); break;
+        case 5: std::cout << "\n[Sharded Zipfian Benchmark in progress...]\n\n"; Sharded_Zipfian(W, R); break;
+        case 6: std::cout << "\n[Sharded Scan Benchmark in progress...]\n\n"; Sharded_Scan(W, R); break;
+
+        default:
+            std::cerr << "Invalid benchmark option provided.\n";
+            printUsage(argv[0]);
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+#ifndef LSM_INDEX_H
+#define LSM_INDEX_H
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+
+#include "skiplist.h"
+#include "bplustree.h"
+
+// Two-tier LSM-style index: writes go into a SkipList memtable, reads are served by a Bplustree.
+//
+// Insert and Delete only touch the active memtable; a Delete is a blind tombstone that hides the key
+// in the older tiers. When the memtable holds 'memtable_keys' entries it is frozen and a background
+// thread merges it into the tree in sorted order (Bplustree::InsertBatch, one descent per leaf) while
+// a new memtable takes the writes. If the previous merge is still running the writer waits for it (a stall).
+//
+// Contains and Scan look at the active memtable, the frozen memtable and the tree, newest first.
+// Only one thread may write (Insert/Delete/Flush); the merge thread is the only other user of the index.
+template<typename Key>
+class LsmIndex {
+   public:
+    explicit LsmIndex(size_t memtable_keys = 1 << 14, int degree = 64);
+    ~LsmIndex(); // Merges what is still frozen and stops the merge thread
+
+    void Insert(const Key& key);
+    bool Contains(const Key& key);
+    // Delete function: Writes a tombstone; the key is not looked up, so nothing is returned.
+    void Delete(const Key& key);
+    std::vector<Key> Scan(const Key& key, const int scan_num);
+
+    // Flush function: Freezes the active memtable and waits until everything is merged into the tree.
+    void Flush();
+
+    size_t Merges() const { return merges; }
+    size_t Stalls() const { return stalls; }
+
+   private:
+    // A memtable: inserted keys and tombstones in two lists, so that a key is in at most one of them.
+    struct Memtable {
+        SkipList<Key> puts;
+        SkipList<Key> tombstones;
+        size_t entries = 0;        // Insert/Delete calls since the memtable was created
+        size_t deleted = 0;        // Delete calls (0 lets Insert skip the tombstone list)
+    };
+
+    // 1 if the key is inserted in 'table', -1 if it has a tombstone there, 0 if 'table' does not know it
+    static int Lookup(const Memtable* table, const Key& key);
+
+    // Helper function to hand the active memtable to the merge thread (waits for the previous merge).
+    void Rotate();
+
+    // Merge thread: merges 'frozen' into the tree each time Rotate signals it.
+    void MergeLoop();
+    void MergeFrozen();
+
+    static constexpr size_t kMergeBatch = 512; // Keys merged per exclusive lock, so readers are not held off long
+
+    Bplustree<Key> tree;
+    Memtable* active;  // Written only by the writer thread, no lock
+    Memtable* frozen;  // Being merged (nullptr if none); replaced and cleared under 'tree_mu'
+    size_t memtable_keys;
+
+    std::shared_mutex tree_mu; // Shared by readers, exclusive for each merge batch and for 'frozen'
+
+    std::mutex merge_mu;       // Guards 'pending' and 'stop'
+    std::condition_variable merge_cv;
+    bool pending;              // 'frozen' is waiting for or under merge
+    bool stop;
+    std::thread merger;
+
+    std::atomic<size_t> merges; // Written by the merge thread
+    size_t stalls;
+};
+
+template<typename Key>
+LsmIndex<Key>::LsmIndex(size_t memtable_keys, int degree)
+    : tree(degree), active(new Memtable()), frozen(nullptr), memtable_keys(memtable_keys),
+      pending(false), stop(false), merges(0), stalls(0) {
+    merger = std::thread(&LsmIndex::MergeLoop, this);
+}
+
+template<typename Key>
+LsmIndex<Key>::~LsmIndex() {
+    {
+        std::lock_guard<std::mutex> lock(merge_mu);
+        stop = true;
+    }
+    merge_cv.notify_all();
+    merger.join();
+    delete active;
+}
+
+template<typename Key>
+int LsmIndex<Key>::Lookup(const Memtable* table, const Key& key) {
+    if (table->puts.Contains(key)) {
+        return 1;
+    }
+    if (table->deleted > 0 && table->tombstones.Contains(key)) {
+        return -1;
+    }
+    return 0;
+}
+
+// Insert function: Puts the key into the active memtable, removing an older tombstone of it.
+template<typename Key>
+void LsmIndex<Key>::Insert(const Key& key) {
+    if (active->deleted > 0) {
+        active->tombstones.Delete(key);
+    }
+    active->puts.Insert(key);
+    if (++active->entries >= memtable_keys) {
+        Rotate();
+    }
+}
+
+// Delete function: Replaces the key by a tombstone in the active memtable.
+template<typename Key>
+void LsmIndex<Key>::Delete(const Key& key) {
+    active->puts.Delete(key);
+    active->tombstones.Insert(key);
+    active->deleted++;
+    if (++active->entries >= memtable_keys) {
+        Rotate();
+    }
+}
+
+// Contains function: The newest tier that knows the key decides.
+template<typename Key>
+bool LsmIndex<Key>::Contains(const Key& key) {
+    int state = Lookup(active, key);
+    if (state != 0) {
+        return state > 0;
+    }
+    std::shared_lock<std::shared_mutex> lock(tree_mu);
+    if (frozen && (state = Lookup(frozen, key)) != 0) {
+        return state > 0;
+    }
+    return tree.Contains(key);
+}
+
+// Scan function: Merges the keys of the three tiers in order and drops the ones hidden by a newer tombstone.
+template<typename Key>
+std::vector<Key> LsmIndex<Key>::Scan(const Key& key, const int scan_num) {
+    std::vector<Key> result;
+    std::shared_lock<std::shared_mutex> lock(tree_mu);
+    Key cursor = key;
+
+    while (result.size() < static_cast<size_t>(scan_num)) {
+        // 1. 새로운 것부터 순서대로 각 목록에서 cursor 이상의 key를 필요한 만큼 가져온다 (홀수 번째는 tombstone)
+        const int want = scan_num - static_cast<int>(result.size());
+        std::vector<Key> runs[5] = {active->puts.Scan(cursor, want),
+                                    active->deleted > 0 ? active->tombstones.Scan(cursor, want) : std::vector<Key>(),
+                                    frozen ? frozen->puts.Scan(cursor, want) : std::vector<Key>(),
+                                    frozen && frozen->deleted > 0 ? frozen->tombstones.Scan(cursor, want) : std::vector<Key>(),
+                                    tree.Scan(cursor, want)};
+
+        // 2. 가득 채워 가져온 목록은 그 마지막 key까지만 빠짐없이 본 것이므로, 그중 가장 작은 key까지만 확정한다
+        bool more = false;
+        Key bound = std::numeric_limits<Key>::max();
+        for (const std::vector<Key>& run : runs) {
+            if (run.size() == static_cast<size_t>(want)) {
+                more = true;
+                bound = std::min(bound, run.back());
+            }
+        }
+
+        // 3. 다섯 목록을 병합한다. 같은 key가 여러 목록에 있으면 가장 새로운 목록이 결정하고, tombstone이면 버린다
+        size_t pos[5] = {0, 0, 0, 0, 0};
+        while (result.size() < static_cast<size_t>(scan_num)) {
+            int from = -1;
+            for (int r = 0; r < 5; r++) {
+                if (pos[r] < runs[r].size() && (from < 0 || runs[r][pos[r]] < runs[from][pos[from]])) {
+                    from = r;
+                }
+            }
+            if (from < 0 || runs[from][pos[from]] > bound) {
+                break;
+            }
+            Key k = runs[from][pos[from]];
+            for (int r = 0; r < 5; r++) {
+                if (pos[r] < runs[r].size() && runs[r][pos[r]] == k) pos[r]++;
+            }
+            if (from % 2 == 0) {
+                result.push_back(k);
+            }
+        }
+
+        if (!more || bound == std::numeric_limits<Key>::max()) {
+            break;
+        }
+        cursor = bound + 1;
+    }
+    return result;
+}
+
+// Flush function: Hands over a non-empty memtable and waits for the merge thread to go idle.
+template<typename Key>
+void LsmIndex<Key>::Flush() {
+    if (active->entries > 0) {
+        Rotate();
+    }
+    std::unique_lock<std::mutex> lock(merge_mu);
+    merge_cv.wait(lock, [this] { return !pending; });
+}
+
+// Rotate function: Freezes the active memtable and wakes the merge thread.
+template<typename Key>
+void LsmIndex<Key>::Rotate() {
+    std::unique_lock<std::mutex> lock(merge_mu);
+    // 1. 이전 memtable이 아직 병합 중이면 끝날 때까지 기다린다
+    if (pending) {
+        stalls++;
+        merge_cv.wait(lock, [this] { return !pending; });
+    }
+
+    // 2. active를 frozen으로 넘기고 새 memtable을 만든다
+    {
+        std::unique_lock<std::shared_mutex> tree_lock(tree_mu);
+        frozen = active;
+    }
+    active = new Memtable();
+    pending = true;
+    merge_cv.notify_all();
+}
+
+// MergeLoop function: Waits for frozen memtables until the index is destroyed.
+template<typename Key>
+void LsmIndex<Key>::MergeLoop() {
+    std::unique_lock<std::mutex> lock(merge_mu);
+    while (true) {
+        merge_cv.wait(lock, [this] { return pending || stop; });
+        if (!pending) {
+            return; // 멈추기 전에 남은 frozen memtable은 모두 병합한다
+        }
+        lock.unlock();
+        MergeFrozen();
+        lock.lock();
+        pending = false;
+        merges++;
+        merge_cv.notify_all();
+    }
+}
+
+// MergeFrozen function: Applies the tombstones and inserts of 'frozen' to the tree in sorted batches.
+template<typename Key>
+void LsmIndex<Key>::MergeFrozen() {
+    // 'frozen'은 pending인 동안 writer가 바꾸지 않으므로 잠금 없이 읽을 수 있다
+    Memtable* table = frozen;
+    std::vector<Key> dead = table->tombstones.Scan(std::numeric_limits<Key>::min(), table->entries);
+    std::vector<Key> live = table->puts.Scan(std::numeric_limits<Key>::min(), table->entries);
+
+    // 1. tombstone을 먼저 적용 (한 key는 두 목록 중 하나에만 있으므로 순서는 결과에 영향이 없다)
+    for (size_t i = 0; i < dead.size(); i += kMergeBatch) {
+        std::unique_lock<std::shared_mutex> tree_lock(tree_mu);
+        for (size_t j = i; j < std::min(i + kMergeBatch, dead.size()); j++) {
+            tree.Delete(dead[j]);
+        }
+    }
+
+    // 2. 삽입된 key들은 리프 단위로 한 번에 병합
+    for (size_t i = 0; i < live.size(); i += kMergeBatch) {
+        std::unique_lock<std::shared_mutex> tree_lock(tree_mu);
+        tree.InsertBatch(live.data() + i, std::min(kMergeBatch, live.size() - i), true);
+    }
+
+    // 3. 병합이 끝나면 reader들이 더 이상 frozen을 보지 않게 하고 해제
+    {
+        std::unique_lock<std::shared_mutex> tree_lock(tree_mu);
+        frozen = nullptr;
+    }
+    delete table;
+}
+
+#endif
@@ -0,0 +1,442 @@
+#ifndef SHARDED_INDEX_H
+#define SHARDED_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+
+// Bounded multi-producer / single-consumer ring (Vyukov): every cell carries a sequence number, so
+// producers claim a slot with one CAS on 'tail' and the consumer needs no atomic read-modify-write at all.
+template<typename T>
+class MpscRing {
+   public:
+    explicit MpscRing(size_t capacity);
+
+    bool TryPush(const T& item);
+    bool TryPop(T& item);
+    bool Empty() const; // Consumer side only
+
+   private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T item;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail; // Next slot to claim (producers)
+    alignas(64) size_t head;              // Next slot to read (consumer)
+};
+
+template<typename T>
+MpscRing<T>::MpscRing(size_t capacity) : tail(0), head(0) {
+    size_t n = 2;
+    while (n < capacity) n <<= 1;
+    cells.reset(new Cell[n]);
+    for (size_t i = 0; i < n; i++) {
+        cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    mask = n - 1;
+}
+
+template<typename T>
+bool MpscRing<T>::TryPush(const T& item) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[pos & mask];
+        size_t seq = cell.seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            // 1. 빈 칸이면 tail을 한 칸 당겨서 차지한다 (실패하면 pos가 갱신되어 다시 시도)
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.item = item;
+                cell.seq.store(pos + 1, std::memory_order_release); // consumer에게 공개
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // 한 바퀴 전의 칸을 consumer가 아직 비우지 않았다 (가득 참)
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+bool MpscRing<T>::TryPop(T& item) {
+    Cell& cell = cells[head & mask];
+    if (cell.seq.load(std::memory_order_acquire) != head + 1) {
+        return false;
+    }
+    item = cell.item;
+    cell.seq.store(head + mask + 1, std::memory_order_release); // 다음 바퀴의 producer에게 돌려준다
+    head++;
+    return true;
+}
+
+template<typename T>
+bool MpscRing<T>::Empty() const {
+    return cells[head & mask].seq.load(std::memory_order_acquire) != head + 1;
+}
+
+// Range-sharded front end: the key space is cut at N-1 split points and every range is owned by its own
+// Index instance (SkipList, Bplustree, ...) that only its worker thread touches. Callers route each
+// operation to the owning shard through that shard's MpscRing, so shards never share a lock or a node.
+// "Pinned" means one dedicated thread per shard; no CPU affinity is set, the scheduler places the threads.
+//
+// Insert and Delete are queued and return at once; Contains and Scan wait for the worker's answer.
+// Operations on one key are applied in the order they were queued. A Scan that runs past the end of
+// a shard continues at the start of the next one.
+//
+// Every 16th routed key is sampled. Every 'rebalance_interval' operations (or on Rebalance()) the split
+// points are moved to the quantiles of the sample if the busiest shard got more than 1.5x the average load,
+// and the keys that changed owner are moved. While that runs all shards are drained and routing waits.
+template<typename Key, typename Index>
+class ShardedIndex {
+   public:
+    // The initial split points divide [0, max_key] evenly; the remaining arguments go to every Index.
+    template<typename... Args>
+    ShardedIndex(int shards, Key max_key, size_t rebalance_interval, Args&&... args);
+    ~ShardedIndex();
+
+    void Insert(const Key& key);
+    void Delete(const Key& key);
+    bool Contains(const Key& key);
+    std::vector<Key> Scan(const Key& key, const int scan_num);
+
+    // Rebalance function: Moves the split points to the sampled load quantiles if the load is skewed.
+    // Returns the number of keys that moved to another shard.
+    size_t Rebalance();
+
+    // Drain function: Waits until every queued operation has been applied.
+    void Drain();
+
+    int Shards() const { return (int)shards.size(); }
+    size_t Rebalances() const { return rebalances; }
+    size_t MovedKeys() const { return moved_keys; }
+
+   private:
+    enum Op { OP_INSERT, OP_DELETE, OP_CONTAINS, OP_SCAN, OP_BARRIER };
+
+    // One queued operation. Synchronous ones point at the caller's reply slots and 'done' flag.
+    struct Request {
+        Op op;
+        Key key;
+        int scan_num;
+        bool* found;
+        std::vector<Key>* keys;
+        std::atomic<bool>* done;
+    };
+
+    struct Shard {
+        template<typename... Args>
+        explicit Shard(Args&&... args) : index(std::forward<Args>(args)...), queue(kQueueSize), sleeping(false) {}
+
+        Index index;
+        MpscRing<Request> queue;
+        std::atomic<bool> sleeping; // The worker is (about to be) blocked on 'cv'
+        std::mutex mu;
+        std::condition_variable cv;
+        std::atomic<size_t> load{0}; // Operations routed here since the last rebalance
+        std::thread worker;
+    };
+
+    static constexpr size_t kQueueSize = 4096;
+    static constexpr size_t kSamples = 4096;
+    static constexpr int kSpins = 64; // Empty polls before a worker goes to sleep
+
+    // Helper function to return the shard owning 'key' (call with 'route_mu' held).
+    size_t ShardOf(const Key& key) const {
+        return std::upper_bound(bounds.begin(), bounds.end(), key) - bounds.begin();
+    }
+
+    // Helper function to queue 'req' on shard 's', waking its worker if it sleeps.
+    void Push(size_t s, const Request& req);
+
+    // Helper function to queue a synchronous request and wait for its reply.
+    void Call(size_t s, Request req);
+
+    // Helper function to move the keys of 'from' in [lo, hi) to their new owners. Returns the number moved.
+    size_t MoveRange(size_t from, const Key& lo, bool has_hi, const Key& hi);
+
+    void WorkerLoop(Shard* shard);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<Key> bounds; // Shard i owns [bounds[i-1], bounds[i])
+
+    std::shared_mutex route_mu; // Shared while routing, exclusive while the split points move
+    std::atomic<bool> stop;
+
+    size_t rebalance_interval;
+    std::atomic<size_t> ops;
+    std::unique_ptr<std::atomic<Key>[]> samples;
+
+    size_t rebalances;
+    size_t moved_keys;
+};
+
+template<typename Key, typename Index>
+template<typename... Args>
+ShardedIndex<Key, Index>::ShardedIndex(int shard_count, Key max_key, size_t rebalance_interval, Args&&... args)
+    : stop(false), rebalance_interval(rebalance_interval), ops(0), samples(new std::atomic<Key>[kSamples]),
+      rebalances(0), moved_keys(0) {
+    for (size_t i = 0; i < kSamples; i++) {
+        samples[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < shard_count; i++) {
+        shards.emplace_back(new Shard(args...));
+        if (i > 0) {
+            bounds.push_back(max_key / shard_count * i);
+        }
+    }
+    for (auto& shard : shards) {
+        shard->worker = std::thread(&ShardedIndex::WorkerLoop, this, shard.get());
+    }
+}
+
+template<typename Key, typename Index>
+ShardedIndex<Key, Index>::~ShardedIndex() {
+    Drain();
+    stop.store(true);
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mu);
+        shard->cv.notify_one();
+    }
+    for (auto& shard : shards) {
+        shard->worker.join();
+    }
+}
+
+template<typename Key, typename Index>
+void ShardedIndex<Key, Index>::Push(size_t s, const Request& req) {
+    Shard& shard = *shards[s];
+    while (!shard.queue.TryPush(req)) {
+        std::this_thread::yield(); // 큐가 가득 찼으면 worker가 비울 때까지 양보
+    }
+    // worker가 잠들려는 중이면 깨운다 (mutex를 잡고 알려야 worker의 마지막 확인과 엇갈리지 않는다)
+    // fence가 없으면 방금 넣은 칸보다 sleeping을 먼저 읽어서, 둘 다 상대를 못 보고 worker가 잠들 수 있다
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (shard.sleeping.load()) {
+        std::lock_guard<std::mutex> lock(shard.mu);
+        shard.cv.notify_one();
+    }
+}
+
+template<typename Key, typename Index>
+void ShardedIndex<Key, Index>::Call(size_t s, Request req) {
+    std::atomic<bool> done(false);
+    req.done = &done;
+    Push(s, req);
+    while (!done.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+// WorkerLoop function: Applies the requests of one shard in queue order.
+template<typename Key, typename Index>
+void ShardedIndex<Key, Index>::WorkerLoop(Shard* shard) {
+    Request req;
+    int idle = 0;
+    while (true) {
+        if (!shard->queue.TryPop(req)) {
+            // 1. 잠깐 기다려 보고, 그래도 비어 있으면 잠든다
+            if (++idle < kSpins) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(shard->mu);
+            shard->sleeping.store(true);
+            shard->cv.wait(lock, [&] { return !shard->queue.Empty() || stop; });
+            shard->sleeping.store(false);
+            if (stop && shard->queue.Empty()) {
+                return;
+            }
+            idle = 0;
+            continue;
+        }
+        idle = 0;
+
+        // 2. 요청 처리, 동기 요청은 결과를 채운 뒤 done으로 알린다
+        switch (req.op) {
+            case OP_INSERT: shard->index.Insert(req.key); break;
+            case OP_DELETE: shard->index.Delete(req.key); break;
+            case OP_CONTAINS: *req.found = shard->index.Contains(req.key); break;
+            case OP_SCAN: *req.keys = shard->index.Scan(req.key, req.scan_num); break;
+            case OP_BARRIER: break;
+        }
+        if (req.done) {
+            req.done->store(true, std::memory_order_release);
+        }
+    }
+}
+
+// Insert function: Queues the key on its shard.
+template<typename Key, typename Index>
+void ShardedIndex<Key, Index>::Insert(const Key& key) {
+    size_t n = ops.fetch_add(1, std::memory_order_relaxed);
+    if (n % 16 == 0) {
+        samples[(n / 16) % kSamples].store(key, std::memory_order_relaxed);
+    }
+    if (rebalance_interval > 0 && n > 0 && n % rebalance_interval == 0) {
+        Rebalance();
+    }
+    std::shared_lock<std::shared_mutex> lock(route_mu);
+    size_t s = ShardOf(key);
+    shards[s]->load.fetch_add(1, std::memory_order_relaxed);
+    Push(s, Request{OP_INSERT, key, 0, nullptr, nullptr, nullptr});
+}
+
+// Delete function: Queues the delete on the shard of the key (nothing is returned, the caller does not wait).
+template<typename Key, typename Index>
+void ShardedIndex<Key, Index>::Delete(const Key& key) {
+    size_t n = ops.fetch_add(1, std::memory_order_relaxed);
+    if (n % 16 == 0) {
+        samples[(n / 16) % kSamples].store(key, std::memory_order_relaxed);
+    }
+    if (rebalance_interval > 0 && n > 0 && n % rebalance_interval == 0) {
+        Rebalance();
+    }
+    std::shared_lock<std::shared_mutex> lock(route_mu);
+    size_t s = ShardOf(key);
+    shards[s]->load.fetch_add(1, std::memory_order_relaxed);
+    Push(s, Request{OP_DELETE, key, 0, nullptr, nullptr, nullptr});
+}
+
+// Contains function: Asks the owning shard and waits for the answer.
+template<typename Key, typename Index>
+bool ShardedIndex<Key, Index>::Contains(const Key& key) {
+    size_t n = ops.fetch_add(1, std::memory_order_relaxed);
+    if (n % 16 == 0) {
+        samples[(n / 16) % kSamples].store(key, std::memory_order_relaxed);
+    }
+    if (rebalance_interval > 0 && n > 0 && n % rebalance_interval == 0) {
+        Rebalance();
+    }
+    bool found = false;
+    std::shared_lock<std::shared_mutex> lock(route_mu);
+    size_t s = ShardOf(key);
+    shards[s]->load.fetch_add(1, std::memory_order_relaxed);
+    Call(s, Request{OP_CONTAINS, key, 0, &found, nullptr, nullptr});
+    return found;
+}
+
+// Scan function: Scans the owning shard and continues into the following shards until 'scan_num' keys are found.
+template<typename Key, typename Index>
+std::vector<Key> ShardedIndex<Key, Index>::Scan(const Key& key, const int scan_num) {
+    std::vector<Key> result;
+    std::vector<Key> part;
+    std::shared_lock<std::shared_mutex> lock(route_mu);
+    Key from = key;
+    for (size_t s = ShardOf(key); s < shards.size() && result.size() < static_cast<size_t>(scan_num); s++) {
+        if (s > 0) {
+            from = std::max(from, bounds[s - 1]);
+        }
+        shards[s]->load.fetch_add(1, std::memory_order_relaxed);
+        Call(s, Request{OP_SCAN, from, scan_num - static_cast<int>(result.size()), nullptr, &part, nullptr});
+        result.insert(result.end(), part.begin(), part.end());
+    }
+    return result;
+}
+
+// Drain function: A barrier through every queue; when all are answered the earlier requests are applied.
+template<typename Key, typename Index>
+void ShardedIndex<Key, Index>::Drain() {
+    std::vector<std::atomic<bool>> done(shards.size());
+    for (size_t s = 0; s < shards.size(); s++) {
+        done[s].store(false);
+        Push(s, Request{OP_BARRIER, Key{}, 0, nullptr, nullptr, &done[s]});
+    }
+    for (size_t s = 0; s < shards.size(); s++) {
+        while (!done[s].load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Rebalance function: Recomputes the split points from the key sample and migrates the keys between shards.
+template<typename Key, typename Index>
+size_t ShardedIndex<Key, Index>::Rebalance() {
+    std::unique_lock<std::shared_mutex> lock(route_mu);
+    if (shards.size() < 2) {
+        return 0;
+    }
+
+    // 1. 부하가 치우치지 않았으면 그대로 둔다
+    size_t total = 0, busiest = 0;
+    for (auto& shard : shards) {
+        size_t load = shard->load.exchange(0, std::memory_order_relaxed);
+        total += load;
+        busiest = std::max(busiest, load);
+    }
+    if (busiest * 2 <= total * 3 / shards.size()) {
+        return 0;
+    }
+
+    // 2. 표본의 분위수로 새 경계를 정한다
+    std::vector<Key> sample(kSamples);
+    size_t sampled = std::min(kSamples, (size_t)ops.load() / 16);
+    for (size_t i = 0; i < sampled; i++) {
+        sample[i] = samples[i].load(std::memory_order_relaxed);
+    }
+    sample.resize(sampled);
+    if (sample.size() < shards.size()) {
+        return 0;
+    }
+    std::sort(sample.begin(), sample.end());
+    std::vector<Key> old_bounds = bounds;
+    for (size_t i = 1; i < shards.size(); i++) {
+        bounds[i - 1] = sample[sample.size() * i / shards.size()];
+    }
+    if (bounds == old_bounds) {
+        return 0;
+    }
+
+    // 3. 모든 큐를 비운 뒤 주인이 바뀐 구간의 key들을 직접 옮긴다. route_mu를 쥐고 있어 새 요청이
+    //    들어오지 않으므로 worker들은 index를 건드리지 않는다 (빈 큐 위에서 아직 돌고 있을 수는 있다)
+    Drain();
+    size_t moved = 0;
+    for (size_t s = 0; s < shards.size(); s++) {
+        bool has_old_lo = s > 0, has_old_hi = s + 1 < shards.size();
+        Key old_lo = has_old_lo ? old_bounds[s - 1] : std::numeric_limits<Key>::min();
+        Key old_hi = has_old_hi ? old_bounds[s] : Key{};
+        Key new_lo = s > 0 ? bounds[s - 1] : std::numeric_limits<Key>::min();
+        if (new_lo > old_lo) {
+            moved += MoveRange(s, old_lo, true, has_old_hi ? std::min(new_lo, old_hi) : new_lo);
+        }
+        if (s + 1 < shards.size() && (!has_old_hi || bounds[s] < old_hi)) {
+            moved += MoveRange(s, std::max(bounds[s], old_lo), has_old_hi, old_hi);
+        }
+    }
+    rebalances++;
+    moved_keys += moved;
+    return moved;
+}
+
+// MoveRange function: Takes the keys of [lo, hi) out of shard 'from' and inserts them into their new shards.
+template<typename Key, typename Index>
+size_t ShardedIndex<Key, Index>::MoveRange(size_t from, const Key& lo, bool has_hi, const Key& hi) {
+    Index& source = shards[from]->index;
+    size_t moved = 0;
+    while (true) {
+        std::vector<Key> keys = source.Scan(lo, 1024);
+        size_t n = 0;
+        while (n < keys.size() && (!has_hi || keys[n] < hi)) n++;
+        if (n == 0) {
+            return moved;
+        }
+        for (size_t i = 0; i < n; i++) {
+            source.Delete(keys[i]);
+            shards[ShardOf(keys[i])]->index.Insert(keys[i]);
+        }
+        moved += n;
+    }
+}
+
+#endif